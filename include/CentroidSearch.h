@@ -0,0 +1,94 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _CENTROIDSEARCH_H_
+#define _CENTROIDSEARCH_H_
+
+#include "Common.h"
+
+#include "DynamicVector.h"
+#include "MemoryPool.h"
+
+/*! \brief The number of centroids in a FixedCentroidBlock (two SSE2
+ *  registers of values).
+ */
+const unsigned int CentroidBlockWidth = 32 / sizeof(Real);
+
+/*! \brief Values of CentroidBlockWidth centroids, interleaved dimension by
+ *  dimension, with a compile-time dimension count.
+ *
+ *  The layout lets the nearest-centroid kernel compute the distances to all
+ *  centroids of a block at once.
+ *
+ *  \tparam N The dimension count.
+ */
+template<unsigned int N>
+struct FixedCentroidBlock
+{
+    Real values[N][CentroidBlockWidth];
+};
+
+/*! \brief Finds the nearest centroid (squared euclidean distance) of
+ *  feature vectors.
+ *
+ *  The common feature dimensions (13, 26 and 39: coefficients, deltas and
+ *  delta-deltas) use FixedCentroidBlock<N> kernels with unrolled dimension
+ *  loops. Other dimensions fall back to DynamicVector::Distance(), as do
+ *  vectors over 160 bytes (26 and 39 doubles) when an AVX2 or AVX-512
+ *  distance kernel is active, because those kernels are as fast there.
+ *
+ *  The search must be constructed again after the centroids change. Ties
+ *  go to the lowest centroid index.
+ */
+class CentroidSearch
+{
+public:
+    /*! \brief Construct for the given centroids.
+     *
+     *  \param centroids The centroids, at least count of them.
+     *  \param count The number of centroids to search.
+     *  \param sizes Optional cluster sizes, centroids of empty clusters
+     *  are skipped.
+     */
+    CentroidSearch(
+        const std::vector< DynamicVector<Real> >& centroids,
+        unsigned int count,
+        const std::vector<unsigned int>* sizes = nullptr);
+
+    /*! \brief Find the nearest centroid of a sample.
+     *
+     *  \param sample Feature vector with the dimensions of the centroids.
+     *
+     *  \return Index of the nearest centroid, -1 if all were skipped.
+     */
+    unsigned int Find(const DynamicVector<Real>& sample) const;
+
+private:
+    typedef unsigned int (*FindFunction)(const CentroidSearch&, const Real*);
+
+    template<unsigned int N>
+    static unsigned int FindFixed(const CentroidSearch& search, const Real* sample);
+
+    static unsigned int FindDynamic(const CentroidSearch& search, const Real* sample);
+
+    template<unsigned int N>
+    void Pack(const std::vector< DynamicVector<Real> >& centroids);
+
+    FindFunction mFind;
+
+    unsigned int mDimensions;
+    unsigned int mBlockCount;
+
+    std::vector< Real, AlignedAllocator<Real> > mBlocks;
+
+    const std::vector< DynamicVector<Real> >* mCentroids;
+    std::vector<unsigned int> mIndices;
+};
+
+/*! \brief Measures CentroidSearch against the DynamicVector::Distance()
+ *  loop for each supported instruction set and the common dimensions.
+ */
+void BenchmarkCentroidSearch();
+
+#endif
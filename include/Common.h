@@ -27,13 +27,26 @@
 #include <vector>
 #include <iomanip>
 #include <functional>
+#include <cstdint>
+#include <sys/stat.h>
 
 #define INDEXFIX
 //#undef INDEXFIX
 
 #define PI_F 3.14159265f
 
+// Store features and models in single precision.
+//#define SINGLE_PRECISION
+
+#ifdef SINGLE_PRECISION
+typedef float Real;
+#else
 typedef double Real;
+#endif
+
+// Sums over many samples (EM statistics, log-likelihoods) are accumulated
+// in double precision regardless of Real.
+typedef double Accumulator;
 
 /*! \brief Returns the sign of a given value.
  *
@@ -230,6 +243,28 @@ inline bool FileExists(const std::string& path)
     return file.good();
 }
 
+/*! \brief Returns the size and modification time of a file.
+ *
+ *  \param path Path to the file.
+ *  \param size Receives the file size in bytes.
+ *  \param time Receives the modification time.
+ *
+ *  \return True if the file exists, false otherwise.
+ */
+inline bool GetFileStatus(const std::string& path, uint64_t& size,
+    int64_t& time)
+{
+    struct stat st;
+
+    if (stat(path.c_str(), &st) != 0)
+        return false;
+
+    size = static_cast<uint64_t>(st.st_size);
+    time = static_cast<int64_t>(st.st_mtime);
+
+    return true;
+}
+
 template <typename T>
 std::string toString(const T& n)
 {
@@ -0,0 +1,52 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _DELTAS_H_
+#define _DELTAS_H_
+
+#include "Common.h"
+
+#include "FeatureMatrix.h"
+
+/*! \brief Number of neighbouring frames on each side used for deltas.
+ */
+const unsigned int DeltaWindow = 2;
+
+/*! \brief Calculates the deltas of consecutive frames.
+ *
+ *  delta(t) = 0.5 * Sigma(n=1 to N)[n*(c(t+n)-c(t-n))] / Sigma(n=1 to N)[n^2]
+ *  with N = DeltaWindow and the first and the last frame repeated at the
+ *  edges, as in scripts/feature_extractor.py.
+ *
+ *  \param input The first value of the first frame.
+ *  \param inputStride Distance between input frames.
+ *  \param output The first delta value of the first frame.
+ *  \param outputStride Distance between output frames.
+ *  \param frameCount The number of frames.
+ *  \param dimensionCount The number of values per frame.
+ */
+void ComputeDeltas(const Real* input, unsigned int inputStride, Real* output,
+    unsigned int outputStride, unsigned int frameCount,
+    unsigned int dimensionCount);
+
+/*! \brief Builds feature vectors with deltas (and delta-deltas).
+ *
+ *  The output rows are [c(t), delta(t), delta-delta(t), ...]. All orders
+ *  are calculated in a single pass over the frames, each order lagging
+ *  DeltaWindow frames behind the previous one, so only a few rows are
+ *  accessed at a time.
+ *
+ *  \param frames The first value of the first frame.
+ *  \param frameCount The number of frames.
+ *  \param dimensionCount The number of values per frame.
+ *  \param stride Distance between frames, 0 if they are packed.
+ *  \param order 0 for none, 1 for deltas, 2 for deltas and delta-deltas.
+ *  \param features Output, dimensionCount * (order + 1) columns, one row
+ *  per frame.
+ */
+void AddDeltas(const Real* frames, unsigned int frameCount,
+    unsigned int dimensionCount, unsigned int stride, unsigned int order,
+    FeatureMatrix& features);
+
+#endif
@@ -7,13 +7,31 @@
 
 #include "Common.h"
 
+#include "MemoryPool.h"
+#include "Simd.h"
+#include "VectorExpression.h"
+
 /*! \brief Multi-dimensional vector.
+ *
+ *  A vector either owns its values or is a view to values stored
+ *  elsewhere (i.e. a row of a FeatureMatrix). Views do not allocate memory
+ *  and the member operations (Assign(), Add(), ...) work on the viewed
+ *  values directly. Copying a view creates an owning vector, moving keeps
+ *  the view. Assigning to a view also gives it values of its own, except
+ *  for pooled vectors (see the pooled constructor), so that e.g. shared
+ *  feature frames cannot be overwritten by accident.
+ *
+ *  Compound updates can be written as vector expressions (see
+ *  VectorExpression), which are evaluated in a single loop.
  *
  *  \tparam T Main data type of the values.
  */
 template<typename T>
-class DynamicVector
+class DynamicVector : public VectorExpression< DynamicVector<T> >
 {
+public:
+    typedef T ValueType;
+
 public:
     /*! \brief Constructor.
      *
@@ -23,19 +41,85 @@ public:
      */
     DynamicVector(unsigned int size = 0);
 
+    /*! \brief View constructor.
+     *
+     *  Creates a view to external values. The values must outlive the view.
+     *
+     *  \param data Pointer to the first value.
+     *  \param size The size of the vector (dimensions).
+     */
+    DynamicVector(T* data, unsigned int size);
+
+    /*! \brief Pooled constructor.
+     *
+     *  Creates a view to zero values allocated from a memory pool (cache
+     *  line aligned, no allocation of its own). The pool must outlive the
+     *  view. Assignments of the same size write to the pooled values.
+     *
+     *  \param pool The memory pool.
+     *  \param size The size of the vector (dimensions).
+     */
+    DynamicVector(MemoryPool& pool, unsigned int size);
+
+    /*! \brief Copy constructor.
+     *
+     *  Copies all elements to a new owning vector.
+     */
+    DynamicVector(const DynamicVector& other);
+
+    /*! \brief Move constructor.
+     *
+     *  Views stay as views.
+     */
+    DynamicVector(DynamicVector&& other) noexcept;
+
+    /*! \brief Expression constructor.
+     *
+     *  Evaluates a vector expression to a new owning vector.
+     */
+    template<typename E>
+    DynamicVector(const VectorExpression<E>& expression);
+
     /*! \brief Virtual destructor.
      */
     virtual ~DynamicVector();
 
     /*! \brief Copy assignment operator.
      *
-     *  Copies all elements.
+     *  Copies all elements. A pooled vector of the same size keeps its
+     *  storage, otherwise the vector will own its values (a view is
+     *  detached from the viewed values). Use Assign() to write through a
+     *  view.
      */
     DynamicVector& operator= (const DynamicVector& other);
 
+    /*! \brief Move assignment operator.
+     *
+     *  Takes over the storage of the other vector, views stay as views.
+     */
+    DynamicVector& operator= (DynamicVector&& other) noexcept;
+
+    /*! \brief Expression assignment operator.
+     *
+     *  Evaluates a vector expression in a single loop. Owning and pooled
+     *  vectors of the same size keep their storage, otherwise the vector
+     *  will own its values (a view is detached from the viewed values).
+     *  Use Assign() to write through a view.
+     */
+    template<typename E>
+    DynamicVector& operator= (const VectorExpression<E>& expression);
+
+    /*! \brief Check if the vector is a view to external values.
+     *
+     *  \return True if the vector is a view, false if it owns its values.
+     */
+    bool IsView() const;
+
     /*! \brief Resize the vector and initialize new values to
      *  a default value.
      *
+     *  A view is turned into an owning vector.
+     *
      *  \param size The size of the vector (dimensions).
      *  \param value The default value.
      */
@@ -50,10 +134,24 @@ public:
     /*! \brief Add a new value and increases the size of
      *  the vector by one.
      *
+     *  A view is turned into an owning vector.
+     *
      *  \param value The value to be added.
      */
     void Push(T value);
 
+    /*! \brief Non-const access to the values.
+     *
+     *  \return Pointer to the first value.
+     */
+    T* GetData();
+
+    /*! \brief Const access to the values.
+     *
+     *  \return Pointer to the first value.
+     */
+    const T* GetData() const;
+
     /*! \brief Non-const access operator.
      */
     T& operator[] (unsigned int index);
@@ -102,6 +200,18 @@ public:
      */
     void Assign(const DynamicVector& other);
 
+    /*! \brief Vector expression evaluation in place.
+     *
+     *  Writes the values of the expression to the current storage, also
+     *  to the viewed values of a view.
+     *
+     *  \note Vector sizes must match.
+     *
+     *  \param expression The vector expression.
+     */
+    template<typename E>
+    void Assign(const VectorExpression<E>& expression);
+
     /*! \brief Vector addition.
      *
      *  \param other The summand.
@@ -124,8 +234,19 @@ public:
      */
     T Distance(const DynamicVector& other) const;
 
+private:
+    /*! \brief Copy viewed values to owned storage.
+     */
+    void Detach();
+
 private:
     std::vector<T> mValues;
+
+    T* mData;
+
+    unsigned int mSize;
+
+    bool mPooled;
 };
 
 #include "DynamicVector.inl"
@@ -4,8 +4,53 @@
 
 template<typename T>
 DynamicVector<T>::DynamicVector(unsigned int size)
+    : mValues(size), mData(mValues.data()), mSize(size), mPooled(false)
 {
-    mValues.resize(size);
+
+}
+
+template<typename T>
+DynamicVector<T>::DynamicVector(T* data, unsigned int size)
+    : mData(data), mSize(size), mPooled(false)
+{
+
+}
+
+template<typename T>
+DynamicVector<T>::DynamicVector(MemoryPool& pool, unsigned int size)
+    : mData(pool.Allocate<T>(size)), mSize(size), mPooled(true)
+{
+
+}
+
+template<typename T>
+DynamicVector<T>::DynamicVector(const DynamicVector& other)
+    : mValues(other.mData, other.mData + other.mSize),
+    mData(mValues.data()), mSize(other.mSize), mPooled(false)
+{
+
+}
+
+template<typename T>
+DynamicVector<T>::DynamicVector(DynamicVector&& other) noexcept
+    : mValues(std::move(other.mValues)), mData(other.mData), mSize(other.mSize),
+    mPooled(other.mPooled)
+{
+    other.mData = other.mValues.data();
+    other.mSize = 0;
+    other.mPooled = false;
+}
+
+template<typename T>
+template<typename E>
+DynamicVector<T>::DynamicVector(const VectorExpression<E>& expression)
+    : mValues(expression.GetExpression().GetSize()), mData(mValues.data()),
+    mSize(static_cast<unsigned int>(mValues.size())), mPooled(false)
+{
+    const E& values = expression.GetExpression();
+
+    for (unsigned int i = 0; i < mSize; ++i)
+        mData[i] = static_cast<T>(values[i]);
 }
 
 template<typename T>
@@ -16,118 +61,202 @@ DynamicVector<T>::~DynamicVector()
 
 template<typename T>
 DynamicVector<T>& DynamicVector<T>::operator= (const DynamicVector& other)
+{
+    if (&other == this)
+        return *this;
+
+    // Same as expression assignment: only pooled storage is kept, views
+    // to external values get values of their own.
+    if (mPooled && other.mSize == mSize) {
+        std::copy(other.mData, other.mData + mSize, mData);
+    } else {
+        mValues.assign(other.mData, other.mData + other.mSize);
+        mData = mValues.data();
+        mSize = other.mSize;
+        mPooled = false;
+    }
+
+    return *this;
+}
+
+template<typename T>
+DynamicVector<T>& DynamicVector<T>::operator= (DynamicVector&& other) noexcept
 {
     if (&other != this) {
-        mValues.resize(other.mValues.size());
-        Assign(other);
+        mValues = std::move(other.mValues);
+        mData = other.mData;
+        mSize = other.mSize;
+        mPooled = other.mPooled;
+
+        other.mValues.clear();
+        other.mData = other.mValues.data();
+        other.mSize = 0;
+        other.mPooled = false;
     }
 
     return *this;
 }
 
+template<typename T>
+template<typename E>
+DynamicVector<T>& DynamicVector<T>::operator= (const VectorExpression<E>& expression)
+{
+    const E& values = expression.GetExpression();
+    unsigned int size = values.GetSize();
+
+    // The expression may read the viewed values, so the old storage stays
+    // valid until all values have been evaluated.
+    if (size != mSize || (IsView() && !mPooled)) {
+        std::vector<T> evaluated(size);
+
+        for (unsigned int i = 0; i < size; ++i)
+            evaluated[i] = static_cast<T>(values[i]);
+
+        mValues.swap(evaluated);
+        mData = mValues.data();
+        mSize = size;
+        mPooled = false;
+
+        return *this;
+    }
+
+    Assign(expression);
+
+    return *this;
+}
+
+template<typename T>
+bool DynamicVector<T>::IsView() const
+{
+    return mData != mValues.data();
+}
+
+template<typename T>
+void DynamicVector<T>::Detach()
+{
+    if (IsView()) {
+        mValues.assign(mData, mData + mSize);
+        mData = mValues.data();
+        mPooled = false;
+    }
+}
+
 template<typename T>
 void DynamicVector<T>::Resize(unsigned int size, T value)
 {
+    Detach();
     mValues.resize(size, value);
+    mData = mValues.data();
+    mSize = size;
 }
 
 template<typename T>
 unsigned int DynamicVector<T>::GetSize() const
 {
-    return mValues.size();
+    return mSize;
 }
 
 template<typename T>
 void DynamicVector<T>::Push(T value)
 {
+    Detach();
     mValues.push_back(value);
+    mData = mValues.data();
+    ++mSize;
+}
+
+template<typename T>
+T* DynamicVector<T>::GetData()
+{
+    return mData;
+}
+
+template<typename T>
+const T* DynamicVector<T>::GetData() const
+{
+    return mData;
 }
 
 template<typename T>
 T& DynamicVector<T>::operator[] (unsigned int index)
 {
-    return mValues[index];
+    return mData[index];
 }
 
 template<typename T>
 const T& DynamicVector<T>::operator[] (unsigned int index) const
 {
-    return mValues[index];
+    return mData[index];
 }
 
 template<typename T>
 void DynamicVector<T>::Assign(T value)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] = value;
+    for (unsigned int i = 0; i < mSize; i++) {
+        mData[i] = value;
     }
 }
 
 template<typename T>
 void DynamicVector<T>::Assign(const DynamicVector& other)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] = other[i];
+    for (unsigned int i = 0; i < mSize; i++) {
+        mData[i] = other.mData[i];
     }
 }
 
+template<typename T>
+template<typename E>
+void DynamicVector<T>::Assign(const VectorExpression<E>& expression)
+{
+    const E& values = expression.GetExpression();
+
+    for (unsigned int i = 0; i < mSize; ++i)
+        mData[i] = static_cast<T>(values[i]);
+}
+
 template<typename T>
 void DynamicVector<T>::Multiply(T value)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] *= value;
+    for (unsigned int i = 0; i < mSize; i++) {
+        mData[i] *= value;
     }
 }
 
 template<typename T>
 void DynamicVector<T>::Multiply(const DynamicVector& other)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] *= other.mValues[i];
-    }
+    VectorMultiply(mData, other.mData, mSize);
 }
 
 template<typename T>
 void DynamicVector<T>::Divide(const DynamicVector& other)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] /= other.mValues[i];
-    }
+    VectorDivide(mData, other.mData, mSize);
 }
 
 template<typename T>
 void DynamicVector<T>::Add(T value)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] += value;
+    for (unsigned int i = 0; i < mSize; i++) {
+        mData[i] += value;
     }
 }
 
 template<typename T>
 void DynamicVector<T>::Add(const DynamicVector& other)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] += other.mValues[i];
-    }
+    VectorAdd(mData, other.mData, mSize);
 }
 
 template<typename T>
 void DynamicVector<T>::Subtract(const DynamicVector& other)
 {
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        mValues[i] -= other.mValues[i];
-    }
+    VectorSubtract(mData, other.mData, mSize);
 }
 
 template<typename T>
 T DynamicVector<T>::Distance(const DynamicVector& other) const
 {
-    T distance = T();
-
-    for (unsigned int i = 0; i < mValues.size(); i++) {
-        T diff = mValues[i] - other.mValues[i];
-        distance += diff * diff;
-    }
-
-    return distance;
+    return VectorDistance(mData, other.mData, mSize);
 }
@@ -0,0 +1,74 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _FFT_H_
+#define _FFT_H_
+
+#include "Common.h"
+
+/*! \class FFT
+ *  \brief Fast Fourier transform of real signals.
+ *
+ *  A real signal of size N is transformed as a complex signal of size N/2
+ *  (radix-2, real and imaginary parts in separate arrays) followed by a
+ *  split step. Sizes that are not powers of two use a direct DFT.
+ *
+ *  \note An instance keeps its own work buffers and must not be shared
+ *  between threads.
+ */
+class FFT
+{
+public:
+    /*! \brief Constructor.
+     *
+     *  \param size The transform size.
+     */
+    FFT(unsigned int size = 0);
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~FFT();
+
+    /*! \brief Set the transform size.
+     *
+     *  \param size The transform size.
+     */
+    void SetSize(unsigned int size);
+
+    /*! \brief Get the transform size.
+     *
+     *  \return The transform size.
+     */
+    unsigned int GetSize() const;
+
+    /*! \brief Calculate the power spectrum of a real signal.
+     *
+     *  \param input Transform size values.
+     *  \param power Squared magnitudes of the bins [0, size/2] (size/2 + 1
+     *  values).
+     */
+    void GetPowerSpectrum(const Real* input, Real* power);
+
+private:
+    /*! \brief In-place complex transform of size/2 values (work buffers).
+     */
+    void Transform();
+
+private:
+    unsigned int mSize;
+
+    bool mPowerOfTwo;
+
+    std::vector<unsigned int> mBitReverse;
+
+    std::vector<Real> mCos; /*!< Twiddle factors, cos(2*pi*k/size). */
+
+    std::vector<Real> mSin; /*!< Twiddle factors, sin(2*pi*k/size). */
+
+    std::vector<Real> mReal;
+
+    std::vector<Real> mImag;
+};
+
+#endif
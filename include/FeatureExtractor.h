@@ -0,0 +1,131 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _FEATUREEXTRACTOR_H_
+#define _FEATUREEXTRACTOR_H_
+
+#include "Common.h"
+
+/*! \class FeatureExtractor
+ *  \brief Batch feature extraction of a speech corpus.
+ *
+ *  Native counterpart of scripts/samples_getter_all.py (and the silenced
+ *  version). The corpus folder has a folder per speaker (e.g. p225) with
+ *  a wave file per utterance (e.g. p225_001.wav). Speakers are numbered
+ *  in order, samples of speaker N are written to samples_N.txt with one
+ *  line per utterance labeled as speaker_utterance (e.g. 225_1).
+ *
+ *  Files of a speaker are extracted concurrently and the sample file is
+ *  written at once after all of them are done.
+ */
+class FeatureExtractor
+{
+public:
+    enum class FeatureType
+    {
+        MFCC,
+        LPC, /*!< Prediction polynomial, as the "lpcc" type of the script. */
+        LPCC
+    };
+
+public:
+    /*! \brief Default constructor.
+     */
+    FeatureExtractor();
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~FeatureExtractor();
+
+    /*! \brief Set the feature type.
+     *
+     *  \param featureType The feature type.
+     */
+    void SetFeatureType(FeatureType featureType);
+
+    /*! \brief Set the number of delta orders.
+     *
+     *  \param deltaOrder 0 for none, 1 for deltas, 2 for deltas and
+     *  delta-deltas.
+     */
+    void SetDeltaOrder(unsigned int deltaOrder);
+
+    /*! \brief Enable silence removal before extraction.
+     *
+     *  \param removeSilence True to remove silent frames of the signal.
+     *
+     *  \see VoiceActivityDetector
+     */
+    void SetRemoveSilence(bool removeSilence);
+
+    /*! \brief Set the number of worker threads.
+     *
+     *  \param threadCount The number of threads, 0 for all hardware threads.
+     */
+    void SetThreadCount(unsigned int threadCount);
+
+    /*! \brief Extract the features of a wave file.
+     *
+     *  \param path Path to the wave file.
+     *  \param label The utterance label.
+     *  \param line Output, the utterance in the text sample format.
+     *  \param frameCount Output, the number of feature vectors.
+     *  \param duration Output, the length of the recording in seconds.
+     *
+     *  \return True if successful, false otherwise.
+     *
+     *  \note Thread-safe.
+     */
+    bool ExtractFile(const std::string& path, const std::string& label,
+        std::string& line, unsigned int& frameCount, Real& duration) const;
+
+    /*! \brief Extract the features of a corpus.
+     *
+     *  \param corpusFolder The corpus folder (speaker folders).
+     *  \param outputFolder The folder of the sample files (existing sample
+     *  files are replaced).
+     *
+     *  \return True if all files were extracted, false otherwise.
+     */
+    bool ExtractCorpus(const std::string& corpusFolder,
+        const std::string& outputFolder) const;
+
+private:
+    FeatureType mFeatureType;
+
+    unsigned int mDeltaOrder;
+
+    bool mRemoveSilence;
+
+    unsigned int mThreadCount;
+};
+
+/*! \brief Measures the throughput of the native front-ends.
+ *
+ *  MFCC, LPC and LPCC features of a generated 16 kHz signal are computed
+ *  and the frames per second printed.
+ *
+ *  \param seconds Length of the generated signal.
+ */
+void BenchmarkFeatureExtraction(Real seconds = 60.0f);
+
+/*! \brief Compares the features of a wave file with reference features.
+ *
+ *  The reference is a text file with one frame per line, e.g. written by
+ *  scripts/frontend_reference.py. The largest absolute and relative
+ *  differences are printed.
+ *
+ *  \param wavePath Path to the wave file.
+ *  \param referencePath Path to the reference features.
+ *  \param featureType The feature type.
+ *  \param tolerance The largest accepted difference relative to
+ *  max(|reference|, 1).
+ *
+ *  \return True if all features are within the tolerance, false otherwise.
+ */
+bool CompareFeatures(const std::string& wavePath,
+    const std::string& referencePath,
+    FeatureExtractor::FeatureType featureType, Real tolerance = 1e-4f);
+
+#endif
@@ -0,0 +1,183 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _FEATUREFILE_H_
+#define _FEATUREFILE_H_
+
+#include "Common.h"
+
+#include "FeatureMatrix.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+
+/*! \brief Converts a text sample file to the binary feature format.
+ *
+ *  Every line of the text file is stored as one utterance so that line
+ *  numbers of the text file and utterance indices of the binary file match.
+ *
+ *  \param textPath Path to a text sample file (samples_N.txt).
+ *  \param binaryPath Path to the binary file to be written.
+ *
+ *  \return True if the conversion succeeded, false otherwise.
+ */
+bool ConvertTextSamples(const std::string& textPath,
+    const std::string& binaryPath);
+
+/*! \brief Appends an utterance to a text sample file.
+ *
+ *  Writes a line in the text sample format: the label followed by feature
+ *  vectors separated by commas, features separated by spaces.
+ *
+ *  \param path Path to a text sample file (created if missing).
+ *  \param label The utterance label.
+ *  \param frames The feature vectors.
+ *
+ *  \return True if the line was written, false otherwise.
+ */
+bool AppendTextSamples(const std::string& path, const std::string& label,
+    const FeatureMatrix& frames);
+
+/*! \brief Writes an utterance in the text sample format.
+ *
+ *  \param stream The output stream.
+ *  \param label The utterance label.
+ *  \param frames The feature vectors.
+ *
+ *  \see AppendTextSamples()
+ */
+void WriteTextSamples(std::ostream& stream, const std::string& label,
+    const FeatureMatrix& frames);
+
+/*! \brief Returns the path of the binary counterpart of a text sample file.
+ *
+ *  \param textPath Path to a text sample file (samples_N.txt).
+ *
+ *  \return The binary file path (samples_N.bin).
+ */
+std::string GetBinarySamplesPath(const std::string& textPath);
+
+/*! \class FeatureFile
+ *  \brief A memory-mapped binary feature container.
+ *
+ *  File layout (native byte order):
+ *  - Header.
+ *  - Frame offset table: utteranceCount + 1 entries (uint64). Frames of
+ *    utterance u are [offsets[u], offsets[u + 1]).
+ *  - Label offset table: utteranceCount + 1 entries (uint32) to the label
+ *    character data.
+ *  - Label character data.
+ *  - Payload: frameCount * dimensionCount float values (row-major),
+ *    aligned to 64 bytes.
+ */
+class FeatureFile
+{
+public:
+    struct Header
+    {
+        char magic[4]; /*!< "SOPF" */
+        uint32_t version;
+        uint32_t dimensionCount;
+        uint32_t utteranceCount;
+        uint64_t frameCount;
+        uint64_t frameOffsetsOffset; /*!< Byte offset of the frame offset table. */
+        uint64_t labelOffsetsOffset; /*!< Byte offset of the label offset table. */
+        uint64_t labelsOffset; /*!< Byte offset of the label character data. */
+        uint64_t payloadOffset; /*!< Byte offset of the feature payload. */
+        uint64_t sourceSize; /*!< Size of the converted text file. */
+        int64_t sourceTime; /*!< Modification time of the converted text file. */
+    };
+
+public:
+    /*! \brief Default constructor.
+     */
+    FeatureFile();
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~FeatureFile();
+
+    /*! \brief Open and validate a binary feature file.
+     *
+     *  \param path Path to the binary feature file.
+     *  \param sourcePath Path to the text file the binary file was converted
+     *  from. If given, the file is rejected when the size or modification
+     *  time of the text file changed since the conversion.
+     *
+     *  \return True if the file is a valid and up-to-date feature file,
+     *  false otherwise.
+     */
+    bool Open(const std::string& path, const std::string& sourcePath = "");
+
+    /*! \brief Close the file.
+     */
+    void Close();
+
+    /*! \brief Check if a valid file is opened.
+     *
+     *  \return True if a file is opened, false otherwise.
+     */
+    bool IsOpen() const;
+
+    /*! \brief Returns the dimension count of all frames.
+     *
+     *  \return The number of feature dimensions.
+     */
+    unsigned int GetDimensionCount() const;
+
+    /*! \brief Returns the number of utterances (text file lines).
+     *
+     *  \return The number of utterances.
+     */
+    unsigned int GetUtteranceCount() const;
+
+    /*! \brief Returns the total number of frames over all utterances.
+     *
+     *  \return The total number of frames.
+     */
+    uint64_t GetFrameCount() const;
+
+    /*! \brief Returns the label of an utterance.
+     *
+     *  \param utterance Utterance index (starts at 0).
+     *
+     *  \return The label, empty if the utterance line had no label.
+     */
+    std::string GetLabel(unsigned int utterance) const;
+
+    /*! \brief Returns the number of frames in an utterance.
+     *
+     *  \param utterance Utterance index (starts at 0).
+     *
+     *  \return The number of frames.
+     */
+    unsigned int GetFrameCount(unsigned int utterance) const;
+
+    /*! \brief Returns the frames of an utterance.
+     *
+     *  \param utterance Utterance index (starts at 0).
+     *
+     *  \return Pointer to the first value of the first frame. Frames are
+     *  stored contiguously, GetDimensionCount() values each.
+     */
+    const float* GetFrames(unsigned int utterance) const;
+
+public:
+    static const uint32_t Version = 2;
+
+private:
+    MappedFile mFile;
+
+    const Header* mHeader;
+
+    const uint64_t* mFrameOffsets;
+
+    const uint32_t* mLabelOffsets;
+
+    const char* mLabels;
+
+    const float* mPayload;
+};
+
+#endif
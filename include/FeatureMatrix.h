@@ -0,0 +1,107 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _FEATUREMATRIX_H_
+#define _FEATUREMATRIX_H_
+
+#include "Common.h"
+
+#include "DynamicVector.h"
+#include "MemoryPool.h"
+
+/*! \class FeatureMatrix
+ *  \brief Contiguous row-major storage for feature vectors.
+ *
+ *  All rows have the same number of columns (feature dimensions). The
+ *  storage starts at a cache line boundary.
+ *
+ *  \note Appending rows may move the storage, which invalidates row
+ *  pointers and views.
+ */
+class FeatureMatrix
+{
+public:
+    /*! \brief Constructor.
+     *
+     *  \param columns The number of columns (feature dimensions).
+     */
+    FeatureMatrix(unsigned int columns = 0);
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~FeatureMatrix();
+
+    /*! \brief Remove all rows and reset the column count.
+     *
+     *  \param columns The new number of columns.
+     */
+    void Clear(unsigned int columns = 0);
+
+    /*! \brief Reserve storage for rows.
+     *
+     *  \param rows The total number of rows to reserve.
+     */
+    void Reserve(unsigned int rows);
+
+    /*! \brief Append uninitialized rows.
+     *
+     *  \param rows The number of rows to append.
+     *
+     *  \return Pointer to the first appended row.
+     */
+    Real* AppendRows(unsigned int rows);
+
+    /*! \brief Remove rows from the end.
+     *
+     *  \param rows The new number of rows (not more than the current).
+     */
+    void Truncate(unsigned int rows);
+
+    /*! \brief Return the number of rows.
+     *
+     *  \return The number of rows.
+     */
+    unsigned int GetRowCount() const;
+
+    /*! \brief Return the number of columns.
+     *
+     *  \return The number of columns (feature dimensions).
+     */
+    unsigned int GetColumnCount() const;
+
+    /*! \brief Non-const access to a row.
+     *
+     *  \param row The row index.
+     *
+     *  \return Pointer to the first value of the row.
+     */
+    Real* GetRow(unsigned int row);
+
+    /*! \brief Const access to a row.
+     *
+     *  \param row The row index.
+     *
+     *  \return Pointer to the first value of the row.
+     */
+    const Real* GetRow(unsigned int row) const;
+
+    /*! \brief Return a view to a row.
+     *
+     *  \param row The row index.
+     *  \param columns The number of columns in the view (from the beginning
+     *  of the row), 0 for all columns.
+     *
+     *  \return A vector viewing the row values.
+     */
+    DynamicVector<Real> GetRowView(unsigned int row, unsigned int columns = 0);
+
+private:
+    std::vector< Real, AlignedAllocator<Real> > mValues;
+
+    unsigned int mColumns;
+
+    unsigned int mRows;
+};
+
+#endif
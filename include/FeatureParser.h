@@ -0,0 +1,87 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _FEATUREPARSER_H_
+#define _FEATUREPARSER_H_
+
+#include "Common.h"
+
+/*! \class FeatureParser
+ *  \brief Parses lines of text sample files.
+ *
+ *  Line format: label followed by feature vectors separated by commas,
+ *  features of a vector separated by spaces.
+ *
+ *  The line is scanned once and the values are written to a contiguous
+ *  frame buffer that is reused between lines, so parsing does not allocate
+ *  memory once the buffers have grown to the size of the longest line.
+ */
+class FeatureParser
+{
+public:
+    /*! \brief Default constructor.
+     */
+    FeatureParser();
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~FeatureParser();
+
+    /*! \brief Parse a line.
+     *
+     *  \param line The line to be parsed.
+     *  \param maxFeatures Maximum number of features to parse per vector
+     *  (from the beginning of the vector), the rest are skipped.
+     *
+     *  \return True if the line has a label, false otherwise.
+     */
+    bool Parse(const std::string& line, unsigned int maxFeatures = -1);
+
+    /*! \brief Returns the label of the parsed line.
+     *
+     *  \return The label.
+     */
+    const std::string& GetLabel() const;
+
+    /*! \brief Returns the number of parsed feature vectors.
+     *
+     *  Empty vectors are not counted.
+     *
+     *  \return The number of feature vectors.
+     */
+    unsigned int GetFrameCount() const;
+
+    /*! \brief Returns the number of features in a parsed vector.
+     *
+     *  \param frame Index of the feature vector.
+     *
+     *  \return The number of features.
+     */
+    unsigned int GetFrameSize(unsigned int frame) const;
+
+    /*! \brief Returns the features of a parsed vector.
+     *
+     *  \param frame Index of the feature vector.
+     *
+     *  \return Pointer to the first feature of the vector.
+     */
+    const float* GetFrame(unsigned int frame) const;
+
+    /*! \brief Check if all parsed vectors have the same size.
+     *
+     *  \return True if the vector sizes match, false otherwise.
+     */
+    bool IsUniform() const;
+
+private:
+    std::string mLabel;
+
+    std::vector<float> mValues;
+
+    std::vector<unsigned int> mFrameOffsets;
+
+    bool mUniform;
+};
+
+#endif
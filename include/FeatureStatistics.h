@@ -0,0 +1,83 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _FEATURESTATISTICS_H_
+#define _FEATURESTATISTICS_H_
+
+#include "Common.h"
+
+#include "DynamicVector.h"
+
+/*! \class FeatureStatistics
+ *  \brief Running mean and variance of feature vectors.
+ *
+ *  Statistics of all dimensions are updated at once as frames arrive
+ *  (Welford's algorithm), so the frames are read only once, row by row.
+ */
+class FeatureStatistics
+{
+public:
+    /*! \brief Constructor.
+     *
+     *  \param dimensionCount The number of feature dimensions.
+     */
+    FeatureStatistics(unsigned int dimensionCount = 0);
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~FeatureStatistics();
+
+    /*! \brief Reset the statistics.
+     *
+     *  \param dimensionCount The new number of feature dimensions.
+     */
+    void Clear(unsigned int dimensionCount);
+
+    /*! \brief Add a frame to the statistics.
+     *
+     *  \param frame Feature values (dimension count values).
+     */
+    void Add(const Real* frame);
+
+    /*! \brief Add a frame to the statistics.
+     *
+     *  \param frame The feature vector.
+     */
+    void Add(const DynamicVector<Real>& frame);
+
+    /*! \brief Returns the number of added frames.
+     *
+     *  \return The number of frames.
+     */
+    unsigned int GetCount() const;
+
+    /*! \brief Returns the number of feature dimensions.
+     *
+     *  \return The number of dimensions.
+     */
+    unsigned int GetDimensionCount() const;
+
+    /*! \brief Returns the means of the added frames.
+     *
+     *  \param means The means of each dimension.
+     */
+    void GetMeans(DynamicVector<Real>& means) const;
+
+    /*! \brief Returns the standard deviations of the added frames.
+     *
+     *  Equation: sqrt[sum((x - mean)^2)/(count - 1)]
+     *
+     *  \param deviations The deviations of each dimension.
+     */
+    void GetDeviations(DynamicVector<Real>& deviations) const;
+
+private:
+    std::vector<Accumulator> mMeans;
+
+    std::vector<Accumulator> mSquares; /*!< sum((x - mean)^2) */
+
+    unsigned int mCount;
+};
+
+#endif
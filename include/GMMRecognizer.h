@@ -8,6 +8,7 @@
 #include "SpeechData.h"
 #include "RecognitionResult.h"
 #include "ModelRecognizer.h"
+#include "GMModel.h"
 
 /*! \class GMMRecognizer
  *  \brief Gaussian Mixture Model speaker recognizer.
@@ -23,12 +24,94 @@ public:
      */
     virtual ~GMMRecognizer();
 
+    /*! \brief Clear all trained data and the cached statistics.
+     */
+    virtual void ClearTrainedData() override;
+
+    /*! \brief Set the number of background model components evaluated in
+     *  the speaker models (top-C Gaussian selection).
+     *
+     *  With the background model and adaptation enabled, the background
+     *  model is evaluated once per sample and the speaker and impostor
+     *  models only for the best components of it.
+     *
+     *  \param count The number of components, 0 to evaluate all.
+     */
+    void SetSelectionCount(unsigned int count);
+
+    /*! \brief Get the number of background model components evaluated in
+     *  the speaker models.
+     *
+     *  \return The number of components, 0 if all are evaluated.
+     */
+    unsigned int GetSelectionCount() const;
+
 protected:
     /*! \brief Create a new Gaussian Mixture Model.
      *
      *  \return A new GMModel instance.
      */
     virtual std::shared_ptr<Model> CreateModel();
+
+    /*! \brief Adapt a speaker model using the cached statistics of the
+     *  speaker against the background model.
+     *
+     *  The statistics are calculated on the first adaptation and reused
+     *  until the background model or the speaker data changes, e.g. when
+     *  only the relevance factor changes. With one adaptation iteration the
+     *  samples are not needed again.
+     *
+     *  \param speaker The speaker.
+     *  \param model The speaker model.
+     *  \param samples The training samples of the speaker.
+     */
+    virtual void AdaptModel(const SpeakerKey& speaker,
+        const std::shared_ptr<Model>& model,
+        const std::vector< DynamicVector<Real> >& samples);
+
+    /*! \brief Scores the samples with the background model once, selects
+     *  its best components if enabled.
+     *
+     *  \param samples The samples to be scored.
+     */
+    virtual void BeginScoring(const std::vector< DynamicVector<Real> >& samples);
+
+    /*! \brief Discards the background model scores.
+     */
+    virtual void EndScoring();
+
+    /*! \brief Speaker/background log-likelihood ratio, using the background
+     *  model scores and selected components if available.
+     *
+     *  \param model The speaker model.
+     *  \param samples The samples to be scored.
+     *
+     *  \return Unnormalized verification score.
+     */
+    virtual Real GetRatio(const std::shared_ptr<Model>& model,
+        const std::vector< DynamicVector<Real> >& samples);
+
+private:
+    unsigned int mSelectionCount;
+
+    GMModel::Selection mSelection;
+
+    bool mSelected; /*!< The selection is valid. */
+
+    GMModel::Workspace mWorkspace;
+
+    /*! \brief The samples being scored, nullptr if none. */
+    const std::vector< DynamicVector<Real> >* mScoringSamples;
+
+    /*! \brief Normalized log-likelihood of the background model. */
+    Real mBackgroundLogLikelihood;
+
+    /*! \brief Statistics of the speakers against mStatisticsModel. */
+    std::map<SpeakerKey, GMModel::Statistics> mStatistics;
+
+    std::shared_ptr<Model> mStatisticsModel;
+
+    std::shared_ptr<SpeechData> mStatisticsData;
 };
 
 #endif
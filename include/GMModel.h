@@ -8,6 +8,7 @@
 #include "Common.h"
 
 #include "DynamicVector.h"
+#include "MemoryPool.h"
 
 #include "Model.h"
 
@@ -25,17 +26,105 @@ public:
 
         // Utility variables do not touch these.
 
-        DynamicVector<Real> meansTmp;
+        DynamicVector<Accumulator> meansTmp;
 
-        DynamicVector<Real> variancesTmp;
+        DynamicVector<Accumulator> variancesTmp;
         DynamicVector<Real> variancesInv;
 
-        Real membershipProbability; /*!< P(k|x_n;phi) */
-        Real membershipProbabilitySum; /*!< sum(P(k|x_n;phi)) */
+        Accumulator membershipProbabilitySum; /*!< sum(P(k|x_n;phi)) */
 
         Real pdfConstant; /*!< A precalculated constant for faster pdf calculations. */
     };
 
+    /*! \brief The clusters arranged for scoring blocks of samples with
+     *  matrix products.
+     */
+    struct PackedClusters
+    {
+        unsigned int dimensions;
+        unsigned int clusterCount;
+
+        std::vector<Real> means; /*!< mean / variance, dimensions x clusters. */
+        std::vector<Real> precisions; /*!< -0.5 / variance, dimensions x clusters. */
+        /*! log(weight) + pdfConstant - 0.5 * sum(mean^2 / variance) of each
+         *  cluster, the sample independent part of the log-likelihood.
+         */
+        std::vector<Real> constants;
+        std::vector<Real> logWeights; /*!< log(weight) + pdfConstant of each cluster. */
+
+        PackedClusters()
+            : dimensions(0), clusterCount(0)
+        {
+
+        }
+    };
+
+    /*! \brief Scratch buffers for scoring.
+     *
+     *  A trained model is not modified by scoring. Threads scoring the same
+     *  model concurrently each use their own workspace, reusing it between
+     *  calls avoids allocating the buffers again.
+     */
+    struct Workspace
+    {
+        std::vector<Real> values; /*!< A block of samples. */
+        std::vector<Real> squares; /*!< The squared samples. */
+        std::vector<Real> logLikelihoods; /*!< Samples x clusters. */
+    };
+
+    /*! \brief Baum-Welch statistics of samples against the model.
+     *
+     *  Calculated once per utterance against a background model, they are
+     *  enough for MAP adaptation without the samples.
+     */
+    struct Statistics
+    {
+        std::vector<Accumulator> zeroOrder; /*!< sum(P(k|x_n)) of each cluster. */
+        std::vector<Accumulator> firstOrder; /*!< sum(P(k|x_n) * x_n), clusters x dimensions. */
+        std::vector<Accumulator> secondOrder; /*!< sum(P(k|x_n) * x_n^2), empty if not calculated. */
+        Accumulator logLikelihood; /*!< Log-likelihood over the samples (not normalized). */
+        unsigned int sampleCount;
+
+        Statistics();
+
+        /*! \brief Resize for a model, the values are not cleared.
+         *
+         *  \param dimensions The number of feature dimensions.
+         *  \param clusterCount The number of clusters.
+         *  \param squares Include the second order statistics.
+         */
+        void Resize(unsigned int dimensions, unsigned int clusterCount,
+            bool squares);
+
+        /*! \brief Set all statistics to zero.
+         */
+        void Clear();
+
+        /*! \brief Add the statistics of other samples.
+         *
+         *  \param other Statistics of the same size.
+         */
+        void Add(const Statistics& other);
+    };
+
+    /*! \brief The best components of a background model for each sample
+     *  (Gaussian selection).
+     */
+    struct Selection
+    {
+        unsigned int count; /*!< The number of components per sample. */
+        unsigned int clusterCount; /*!< The order of the background model. */
+        std::vector<unsigned int> components; /*!< Samples x count, best first. */
+        Real logLikelihood; /*!< Normalized log-likelihood of the background
+                                 model over the selected components. */
+
+        Selection()
+            : count(0), clusterCount(0), logLikelihood(0.0f)
+        {
+
+        }
+    };
+
 public:
     /*! \brief Default constructor.
      */
@@ -69,6 +158,20 @@ public:
      */
     Real GetTrainingThreshold() const;
 
+    /*! \brief Set the maximum number of threads used in model training.
+     *
+     *  The results do not depend on the number of threads.
+     *
+     *  \param threads The number of threads, 0 for all hardware threads.
+     */
+    void SetTrainingThreads(unsigned int threads);
+
+    /*! \brief Get the maximum number of threads used in model training.
+     *
+     *  \return The number of threads, 0 for all hardware threads.
+     */
+    unsigned int GetTrainingThreads() const;
+
     /*! Initialize the model with default values.
      */
     void Init();
@@ -98,6 +201,32 @@ public:
         const std::vector< DynamicVector<Real> >& samples,
         unsigned int iterations = 2, Real relevanceFactor = 16.0f) override;
 
+    /*! \brief Adapt the model from another model using statistics
+     *  calculated with it (see GetStatistics()).
+     *
+     *  The first MAP iteration only uses the statistics, further iterations
+     *  recalculate them from the samples.
+     *
+     *  \param other The model to adapt from.
+     *  \param statistics Statistics of the training samples against other.
+     *  \param samples The training samples, may be empty for one iteration.
+     *  \param iterations The number of MAP iterations.
+     *  \param relevanceFactor The MAP relevance factor.
+     */
+    void Adapt(const std::shared_ptr<Model>& other,
+        const Statistics& statistics,
+        const std::vector< DynamicVector<Real> >& samples,
+        unsigned int iterations = 1, Real relevanceFactor = 16.0f);
+
+    /*! \brief Calculate the Baum-Welch statistics of samples.
+     *
+     *  \param samples Samples of independent observations.
+     *  \param statistics Output, the statistics.
+     *  \param secondOrder Calculate the second order statistics too.
+     */
+    void GetStatistics(const std::vector< DynamicVector<Real> >& samples,
+        Statistics& statistics, bool secondOrder = false) const;
+
     /*! \brief Calculate the normalized log-likelihood value over given samples.
      *
      *  The normalization is done by averaging log-likelihoods by dividing
@@ -110,6 +239,49 @@ public:
     Real GetLogLikelihood(
         const std::vector< DynamicVector<Real> >& samples) const;
 
+    /*! \brief Calculate the normalized log-likelihood value over given samples.
+     *
+     *  Thread-safe, all temporary values are kept in the workspace.
+     *
+     *  \param samples Samples of independent observations.
+     *  \param workspace Scratch buffers, not shared with other threads.
+     *
+     *  \return Normalized log-likelihood.
+     */
+    Real GetLogLikelihood(const std::vector< DynamicVector<Real> >& samples,
+        Workspace& workspace) const;
+
+    /*! \brief Select the components with the highest likelihoods for
+     *  each sample.
+     *
+     *  Used on a background model, the selection applies to all the models
+     *  adapted from it (see GetLogLikelihood()).
+     *
+     *  \param samples Samples of independent observations.
+     *  \param count The number of components per sample.
+     *  \param selection Output, the best components of each sample and
+     *  the normalized log-likelihood of this model over them.
+     *  \param workspace Scratch buffers, not shared with other threads.
+     */
+    void SelectComponents(const std::vector< DynamicVector<Real> >& samples,
+        unsigned int count, Selection& selection, Workspace& workspace) const;
+
+    /*! \brief Calculate the normalized log-likelihood value over given
+     *  samples using only the selected components.
+     *
+     *  The model must be adapted from the model that made the selection,
+     *  the components of both models correspond one to one. The other
+     *  components are assumed to contribute nothing.
+     *
+     *  \param samples Samples of independent observations.
+     *  \param selection The components selected by SelectComponents().
+     *  \param workspace Scratch buffers, not shared with other threads.
+     *
+     *  \return Normalized log-likelihood.
+     */
+    Real GetLogLikelihood(const std::vector< DynamicVector<Real> >& samples,
+        const Selection& selection, Workspace& workspace) const;
+
     /*! \brief Score given samples.
      *
      *  \param samples Samples of independent observations.
@@ -128,6 +300,16 @@ public:
     virtual Real GetLogScore(
         const std::vector< DynamicVector<Real> >& samples) const override;
 
+    /*! \brief Log-score given samples using caller's scratch buffers.
+     *
+     *  \param samples Samples of independent observations.
+     *  \param workspace Scratch buffers, not shared with other threads.
+     *
+     *  \return Average log-score over samples.
+     */
+    Real GetLogScore(const std::vector< DynamicVector<Real> >& samples,
+        Workspace& workspace) const;
+
     /*! \brief Get the number of feature dimensions used in the model.
      *
      *  \return The number of feature dimensions.
@@ -135,6 +317,14 @@ public:
     virtual unsigned int GetDimensionCount() const override;
 
 private:
+    /*! \brief Allocate the vectors of all clusters from the memory pool.
+     *
+     *  Releases the previous vectors, all values are zero.
+     *
+     *  \param dimensions The number of feature dimensions.
+     */
+    void AllocateClusters(unsigned int dimensions);
+
     /*! \brief Initializes cluster variables before the actual EM-algorithm.
      *
      *  \param samples Samples of independent observations.
@@ -153,7 +343,7 @@ private:
      *
      *  \return Log-likelihood over samples.
      */
-    Real E(const std::vector< DynamicVector<Real> >& samples);
+    Accumulator E(const std::vector< DynamicVector<Real> >& samples);
 
     /*! \brief The M-step of the EM-algorithm.
      *
@@ -162,16 +352,12 @@ private:
     void M(const std::vector< DynamicVector<Real> >& samples);
 
 private:
-    /*! \brief Calculate the log-likelihood of the given sample
-     *  using given cluster values.
+    /*! \brief One MAP iteration, adapts the means.
      *
-     *  \param values Feature values.
-     *  \param cluster A cluster that defines the pdf.
-     *
-     *  \return Log-likelihood
+     *  \param statistics Statistics of the training samples.
+     *  \param relevanceFactor The MAP relevance factor.
      */
-    Real GetLogLikelihood(
-        const DynamicVector<Real>& values, const Cluster& cluster) const;
+    void AdaptMeans(const Statistics& statistics, Real relevanceFactor);
 
     /*! \brief Precalculates constant pdf values for efficiency.
      *
@@ -184,9 +370,15 @@ private:
 
     Real mEta;
 
+    unsigned int mTrainingThreads;
+
     bool mValid;
 
-    mutable std::vector<Cluster> mClusters;
+    std::vector<Cluster> mClusters;
+
+    PackedClusters mPackedClusters; /*!< The trained clusters for scoring. */
+
+    MemoryPool mPool; /*!< Storage of the cluster vectors. */
 };
 
 #endif
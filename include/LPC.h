@@ -0,0 +1,149 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _LPC_H_
+#define _LPC_H_
+
+#include "Common.h"
+
+#include "FeatureMatrix.h"
+#include "WaveFile.h"
+
+/*! \class LPC
+ *  \brief Linear prediction front-end (LPC and LPC cepstrum).
+ *
+ *  Frames the signal like the python features package (rectangular frames,
+ *  the last frame zero padded), calculates the biased autocorrelation of
+ *  each frame and solves the prediction coefficients with the
+ *  Levinson-Durbin recursion.
+ *
+ *  Without cepstral coefficients the output is the prediction polynomial
+ *  [1, a1, ..., ap], the same values get_lpcc() of
+ *  scripts/feature_extractor.py writes (scikits.talkbox lpc()). Otherwise
+ *  the polynomial is converted to cepstral coefficients of the all-pole
+ *  model, the first coefficient being the log prediction error.
+ *
+ *  \note An instance keeps its own work buffers and must not be shared
+ *  between threads.
+ */
+class LPC
+{
+public:
+    struct Parameters
+    {
+        Real frameLength = 0.025f; /*!< Frame length in seconds. */
+        Real frameStep = 0.01f; /*!< Frame step in seconds. */
+        unsigned int order = 12; /*!< Prediction order. */
+        unsigned int cepstrumCount = 13; /*!< Cepstral coefficients, 0 for the prediction polynomial. */
+    };
+
+public:
+    /*! \brief Default constructor (default parameters).
+     */
+    LPC();
+
+    /*! \brief Constructor.
+     *
+     *  \param parameters The front-end parameters.
+     */
+    LPC(const Parameters& parameters);
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~LPC();
+
+    /*! \brief Set the front-end parameters.
+     *
+     *  \param parameters The new parameters.
+     */
+    void SetParameters(const Parameters& parameters);
+
+    /*! \brief Get the front-end parameters.
+     *
+     *  \return The parameters.
+     */
+    const Parameters& GetParameters() const;
+
+    /*! \brief Returns the number of values per frame.
+     *
+     *  \return The cepstrum count, or order + 1 for the prediction
+     *  polynomial.
+     */
+    unsigned int GetColumnCount() const;
+
+    /*! \brief Returns the number of frames in a signal.
+     *
+     *  The last frame is padded with zeros, a signal has at least one frame.
+     *
+     *  \param length The number of samples.
+     *  \param sampleRate The sample rate (Hz).
+     *
+     *  \return The number of frames.
+     */
+    unsigned int GetFrameCount(unsigned int length, unsigned int sampleRate) const;
+
+    /*! \brief Compute the coefficients of a signal.
+     *
+     *  \param signal The samples.
+     *  \param length The number of samples.
+     *  \param sampleRate The sample rate (Hz).
+     *  \param features Output, GetColumnCount() columns, one row per frame.
+     */
+    void Compute(const Real* signal, unsigned int length,
+        unsigned int sampleRate, FeatureMatrix& features);
+
+    /*! \brief Compute the coefficients of a wave file.
+     *
+     *  The samples are read and converted a chunk of frames at a time.
+     *
+     *  \param file An open wave file.
+     *  \param features Output, GetColumnCount() columns, one row per frame.
+     *  \param chunkFrames The number of frames per chunk.
+     */
+    void Compute(const WaveFile& file, FeatureMatrix& features,
+        unsigned int chunkFrames = DefaultChunkFrames);
+
+public:
+    static const unsigned int DefaultChunkFrames = 1000; /*!< 10 s of 10 ms frames. */
+
+private:
+    /*! \brief Compute the coefficients of consecutive frames.
+     *
+     *  \param samples Samples of the signal starting from sample offset,
+     *  from the first frame to the end of the last frame (or the signal).
+     *  \param offset Index of the first given sample in the signal.
+     *  \param length The number of samples in the whole signal.
+     *  \param sampleRate The sample rate (Hz).
+     *  \param firstFrame Index of the first frame.
+     *  \param frameCount The number of frames.
+     *  \param coefficients Output, GetColumnCount() values per frame.
+     */
+    void ComputeFrames(const Real* samples, unsigned int offset,
+        unsigned int length, unsigned int sampleRate, unsigned int firstFrame,
+        unsigned int frameCount, Real* coefficients);
+
+    /*! \brief Compute the coefficients of a single frame.
+     *
+     *  \param frame The samples of the frame.
+     *  \param available The number of samples, the rest of the frame is
+     *  zeros.
+     *  \param frameLength The frame length including the zeros.
+     *  \param coefficients Output, GetColumnCount() values.
+     */
+    void ComputeFrame(const Real* frame, unsigned int available,
+        unsigned int frameLength, Real* coefficients);
+
+private:
+    Parameters mParameters;
+
+    std::vector<Accumulator> mAutocorrelation;
+
+    std::vector<Accumulator> mPolynomial; /*!< [1, a1, ..., ap] */
+
+    std::vector<Accumulator> mPrevious; /*!< Polynomial of the previous order. */
+
+    std::vector<Accumulator> mCepstrum;
+};
+
+#endif
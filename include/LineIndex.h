@@ -0,0 +1,105 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _LINEINDEX_H_
+#define _LINEINDEX_H_
+
+#include "Common.h"
+
+#include "MappedFile.h"
+
+#include <cstdint>
+
+/*! \brief Returns the path of the line index sidecar of a text file.
+ *
+ *  \param textPath Path to a text file (samples_N.txt).
+ *
+ *  \return The sidecar path (samples_N.txt.idx).
+ */
+std::string GetLineIndexPath(const std::string& textPath);
+
+/*! \class LineIndex
+ *  \brief Byte offsets of the lines of a text file.
+ *
+ *  The index is stored in a sidecar file next to the indexed file. It is
+ *  built once and rebuilt automatically whenever the size or the
+ *  modification time of the indexed file changes.
+ *
+ *  Sidecar layout (native byte order):
+ *  - Header.
+ *  - lineCount byte offsets (uint64) to the beginning of each line.
+ */
+class LineIndex
+{
+public:
+    struct Header
+    {
+        char magic[4]; /*!< "SOPI" */
+        uint32_t version;
+        uint64_t lineCount;
+        uint64_t fileSize; /*!< Size of the indexed file. */
+        int64_t fileTime; /*!< Modification time of the indexed file. */
+    };
+
+public:
+    /*! \brief Default constructor.
+     */
+    LineIndex();
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~LineIndex();
+
+    /*! \brief Open the line index of a text file.
+     *
+     *  Builds (and saves) the index if the sidecar is missing or stale.
+     *
+     *  \param path Path to the indexed text file.
+     *
+     *  \return True if the index is available, false otherwise.
+     */
+    bool Open(const std::string& path);
+
+    /*! \brief Close the index.
+     */
+    void Close();
+
+    /*! \brief Returns the number of lines in the indexed file.
+     *
+     *  \return The number of lines.
+     */
+    unsigned int GetLineCount() const;
+
+    /*! \brief Returns the byte offset of a line.
+     *
+     *  \param line Line number (starts at 1).
+     *
+     *  \return The byte offset of the beginning of the line.
+     */
+    uint64_t GetOffset(unsigned int line) const;
+
+private:
+    /*! \brief Build the index by scanning the text file.
+     *
+     *  \param path Path to the indexed text file.
+     *  \param header Header with file size and time set.
+     *
+     *  \return True if the file could be scanned, false otherwise.
+     */
+    bool Build(const std::string& path, Header& header);
+
+public:
+    static const uint32_t Version = 1;
+
+private:
+    MappedFile mFile;
+
+    const uint64_t* mOffsets;
+
+    std::vector<uint64_t> mBuiltOffsets;
+
+    unsigned int mLineCount;
+};
+
+#endif
@@ -0,0 +1,166 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _MFCC_H_
+#define _MFCC_H_
+
+#include "Common.h"
+
+#include "FeatureMatrix.h"
+#include "FFT.h"
+#include "WaveFile.h"
+
+/*! \class MFCC
+ *  \brief Mel-frequency cepstral coefficient front-end.
+ *
+ *  Computes the same features as the mfcc() function of the python
+ *  features package used by scripts/feature_extractor.py (with the same
+ *  defaults): pre-emphasis, rectangular frames, power spectrum (frames
+ *  longer than the FFT size are truncated), triangular mel filterbank,
+ *  log, orthonormal DCT-II, liftering and the first coefficient replaced
+ *  by the log frame energy.
+ *
+ *  \note An instance keeps its own work buffers and must not be shared
+ *  between threads.
+ */
+class MFCC
+{
+public:
+    struct Parameters
+    {
+        Real frameLength = 0.025f; /*!< Frame length in seconds. */
+        Real frameStep = 0.01f; /*!< Frame step in seconds. */
+        unsigned int cepstrumCount = 13;
+        unsigned int filterCount = 26;
+        unsigned int fftSize = 512;
+        Real lowFrequency = 0.0f; /*!< Lowest filterbank frequency (Hz). */
+        Real highFrequency = 0.0f; /*!< Highest filterbank frequency (Hz), 0 for half the sample rate. */
+        Real preemphasis = 0.97f; /*!< Pre-emphasis coefficient, 0 for none. */
+        unsigned int lifter = 22; /*!< Cepstral lifter, 0 for none. */
+        bool appendEnergy = true; /*!< Replace the first coefficient with the log frame energy. */
+    };
+
+public:
+    /*! \brief Default constructor (default parameters).
+     */
+    MFCC();
+
+    /*! \brief Constructor.
+     *
+     *  \param parameters The front-end parameters.
+     */
+    MFCC(const Parameters& parameters);
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~MFCC();
+
+    /*! \brief Set the front-end parameters.
+     *
+     *  \param parameters The new parameters.
+     */
+    void SetParameters(const Parameters& parameters);
+
+    /*! \brief Get the front-end parameters.
+     *
+     *  \return The parameters.
+     */
+    const Parameters& GetParameters() const;
+
+    /*! \brief Returns the number of frames in a signal.
+     *
+     *  The last frame is padded with zeros, a signal has at least one frame.
+     *
+     *  \param length The number of samples.
+     *  \param sampleRate The sample rate (Hz).
+     *
+     *  \return The number of frames.
+     */
+    unsigned int GetFrameCount(unsigned int length, unsigned int sampleRate) const;
+
+    /*! \brief Compute the coefficients of a signal.
+     *
+     *  \param signal The samples (e.g. 16-bit values as is).
+     *  \param length The number of samples.
+     *  \param sampleRate The sample rate (Hz).
+     *  \param features Output, cepstrum count columns, one row per frame.
+     */
+    void Compute(const Real* signal, unsigned int length,
+        unsigned int sampleRate, FeatureMatrix& features);
+
+    /*! \brief Compute the coefficients of a wave file.
+     *
+     *  The samples are read and converted a chunk of frames at a time.
+     *
+     *  \param file An open wave file.
+     *  \param features Output, cepstrum count columns, one row per frame.
+     *  \param chunkFrames The number of frames per chunk.
+     */
+    void Compute(const WaveFile& file, FeatureMatrix& features,
+        unsigned int chunkFrames = DefaultChunkFrames);
+
+public:
+    static const unsigned int DefaultChunkFrames = 1000; /*!< 10 s of 10 ms frames. */
+
+private:
+    /*! \brief Precalculate the filterbank and DCT for a sample rate.
+     *
+     *  \param sampleRate The sample rate (Hz).
+     */
+    void Prepare(unsigned int sampleRate);
+
+    /*! \brief Compute the coefficients of consecutive frames.
+     *
+     *  \param samples Samples of the signal starting from sample offset,
+     *  from the sample preceding the first frame to the end of the last
+     *  frame (or the signal).
+     *  \param offset Index of the first given sample in the signal.
+     *  \param length The number of samples in the whole signal.
+     *  \param firstFrame Index of the first frame.
+     *  \param frameCount The number of frames.
+     *  \param coefficients Output, cepstrum count values per frame.
+     */
+    void ComputeFrames(const Real* samples, unsigned int offset,
+        unsigned int length, unsigned int firstFrame, unsigned int frameCount,
+        Real* coefficients);
+
+    /*! \brief Compute the coefficients of a block of frames.
+     *
+     *  The filterbank and the DCT are applied to all frames of the block
+     *  as matrix products, vectorized over the frames.
+     *
+     *  \param frameCount The number of frames, power spectra in mPower.
+     *  \param coefficients Output, cepstrum count values per frame.
+     */
+    void ComputeBlock(unsigned int frameCount, Real* coefficients);
+
+private:
+    Parameters mParameters;
+
+    FFT mFFT;
+
+    unsigned int mSampleRate; /*!< The sample rate the tables are for. */
+
+    std::vector<unsigned int> mFilterBegin; /*!< First bin of each filter. */
+
+    std::vector<unsigned int> mFilterOffsets; /*!< Offsets to mFilterWeights. */
+
+    std::vector<Real> mFilterWeights; /*!< Non-zero weights of each filter. */
+
+    std::vector<Real> mDCT; /*!< Liftered DCT-II, cepstrum count x filter count. */
+
+    std::vector<Real> mFrame;
+
+    std::vector<Real> mSpectrum;
+
+    std::vector<Real> mPower; /*!< Power spectra of a block, bin count x frames. */
+
+    std::vector<Accumulator> mFrameEnergies; /*!< Total energy of each frame of a block. */
+
+    std::vector<Real> mEnergies; /*!< Filterbank energies of a block, filter count x frames. */
+
+    std::vector<Real> mCoefficients; /*!< Cepstra of a block, cepstrum count x frames. */
+};
+
+#endif
@@ -0,0 +1,79 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _MAPPEDFILE_H_
+#define _MAPPEDFILE_H_
+
+#include "Common.h"
+
+/*! \class MappedFile
+ *  \brief A read-only memory-mapped file.
+ *
+ *  The file contents are mapped to the address space of the process so
+ *  that the data can be accessed directly without reading or copying.
+ */
+class MappedFile
+{
+public:
+    /*! \brief Default constructor.
+     */
+    MappedFile();
+
+    /*! \brief Virtual destructor.
+     *
+     *  Unmaps the file.
+     */
+    virtual ~MappedFile();
+
+    /*! \brief Map a file to memory.
+     *
+     *  A previously mapped file will be unmapped.
+     *
+     *  \param path Path to the file.
+     *
+     *  \return True if the file was mapped successfully, false otherwise.
+     */
+    bool Open(const std::string& path);
+
+    /*! \brief Unmap the file.
+     */
+    void Close();
+
+    /*! \brief Check if a file is mapped.
+     *
+     *  \return True if a file is mapped, false otherwise.
+     */
+    bool IsOpen() const;
+
+    /*! \brief Get the mapped data.
+     *
+     *  \return Pointer to the beginning of the file, nullptr if the file
+     *  is not mapped or empty.
+     */
+    const char* GetData() const;
+
+    /*! \brief Get the size of the mapped file.
+     *
+     *  \return The size of the file in bytes.
+     */
+    std::size_t GetSize() const;
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator= (const MappedFile&) = delete;
+
+private:
+    const char* mData;
+
+    std::size_t mSize;
+
+    bool mOpen;
+
+#ifdef _WIN32
+    void* mFileHandle;
+    void* mMappingHandle;
+#endif
+};
+
+#endif
@@ -0,0 +1,171 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _MEMORYPOOL_H_
+#define _MEMORYPOOL_H_
+
+#include "Common.h"
+
+#include <cstdlib>
+#include <type_traits>
+
+/*! \brief Alignment of pooled and aligned allocations (a cache line, also
+ *  enough for AVX-512 loads).
+ */
+const std::size_t CacheLineSize = 64;
+
+/*! \brief Allocate memory aligned to CacheLineSize.
+ *
+ *  \param bytes The number of bytes.
+ *
+ *  \return Pointer to the memory, must be freed with FreeAligned().
+ */
+void* AllocateAligned(std::size_t bytes);
+
+/*! \brief Free memory allocated with AllocateAligned().
+ *
+ *  \param pointer Pointer to the memory or nullptr.
+ */
+void FreeAligned(void* pointer);
+
+/*! \brief Standard allocator returning memory aligned to CacheLineSize.
+ *
+ *  Used for large contiguous buffers, e.g. std::vector<Real,
+ *  AlignedAllocator<Real> >.
+ */
+template<typename T>
+class AlignedAllocator
+{
+public:
+    typedef T value_type;
+
+    AlignedAllocator()
+    {
+
+    }
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U>&)
+    {
+
+    }
+
+    T* allocate(std::size_t count)
+    {
+        void* pointer = AllocateAligned(count * sizeof(T));
+
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+
+        return static_cast<T*>(pointer);
+    }
+
+    void deallocate(T* pointer, std::size_t)
+    {
+        FreeAligned(pointer);
+    }
+};
+
+template<typename T, typename U>
+bool operator== (const AlignedAllocator<T>&, const AlignedAllocator<U>&)
+{
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!= (const AlignedAllocator<T>&, const AlignedAllocator<U>&)
+{
+    return false;
+}
+
+/*! \class MemoryPool
+ *  \brief Arena of cache line aligned values.
+ *
+ *  Values are taken from large blocks one after another, every allocation
+ *  starting at a new cache line. Nothing is freed individually, all blocks
+ *  are released together by Release() or the destructor. Used for the many
+ *  small vectors of a model (see DynamicVector).
+ *
+ *  \note Not thread-safe.
+ */
+class MemoryPool
+{
+public:
+    /*! \brief Constructor.
+     *
+     *  \param blockSize The size of a block in bytes, larger allocations
+     *  get a block of their own.
+     */
+    MemoryPool(std::size_t blockSize = DefaultBlockSize);
+
+    /*! \brief Virtual destructor, releases all blocks.
+     */
+    virtual ~MemoryPool();
+
+    /*! \brief Allocate zero-initialized values.
+     *
+     *  \param count The number of values.
+     *
+     *  \return Pointer to the first value, valid until Release().
+     */
+    template<typename T>
+    T* Allocate(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+            "Pooled values are never destructed.");
+
+        T* values = static_cast<T*>(Allocate(count * sizeof(T)));
+
+        std::fill(values, values + count, T());
+
+        return values;
+    }
+
+    /*! \brief Allocate uninitialized memory.
+     *
+     *  \param bytes The number of bytes.
+     *
+     *  \return Pointer to the memory, valid until Release().
+     */
+    void* Allocate(std::size_t bytes);
+
+    /*! \brief Release all blocks, invalidates all allocations.
+     */
+    void Release();
+
+    /*! \brief Return the number of allocations since the last release.
+     */
+    std::size_t GetAllocationCount() const;
+
+    /*! \brief Return the number of blocks currently allocated.
+     */
+    std::size_t GetBlockCount() const;
+
+    /*! \brief Return the number of bytes currently allocated in blocks.
+     */
+    std::size_t GetCapacity() const;
+
+public:
+    static const std::size_t DefaultBlockSize = 64 * 1024;
+
+private:
+    MemoryPool(const MemoryPool&) = delete;
+
+    MemoryPool& operator= (const MemoryPool&) = delete;
+
+private:
+    std::size_t mBlockSize;
+
+    std::vector<void*> mBlocks;
+
+    char* mPosition; /*!< Next free byte of the last block. */
+
+    std::size_t mRemaining; /*!< Free bytes in the last block. */
+
+    std::size_t mCapacity;
+
+    std::size_t mAllocationCount;
+};
+
+#endif
@@ -301,6 +301,16 @@ protected:
      */
     virtual std::shared_ptr<Model> CreateModel() = 0;
 
+    /*! \brief Adapt a speaker model from the background model.
+     *
+     *  \param speaker The speaker.
+     *  \param model The speaker model.
+     *  \param samples The training samples of the speaker.
+     */
+    virtual void AdaptModel(const SpeakerKey& speaker,
+        const std::shared_ptr<Model>& model,
+        const std::vector< DynamicVector<Real> >& samples);
+
     /*! \brief Post-process models after training.
      */
     virtual void PrepareModels();
@@ -321,6 +331,18 @@ protected:
     virtual Real GetRatio(const std::shared_ptr<Model>& model,
         const std::vector< DynamicVector<Real> >& samples);
 
+    /*! \brief Called before scoring several models with the same samples.
+     *
+     *  GetRatio() is called only with these samples until EndScoring().
+     *
+     *  \param samples The samples to be scored.
+     */
+    virtual void BeginScoring(const std::vector< DynamicVector<Real> >& samples);
+
+    /*! \brief Called after scoring the samples given to BeginScoring().
+     */
+    virtual void EndScoring();
+
     /* \brief Get the trained background model.
      *
      * \return Pointer to the trained background model, nullptr otherwise.
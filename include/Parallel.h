@@ -0,0 +1,41 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include "Common.h"
+
+/*! \brief Returns the number of worker threads to use.
+ *
+ *  \return The number of hardware threads (at least 1).
+ */
+unsigned int GetThreadCount();
+
+/*! \brief Runs tasks concurrently.
+ *
+ *  Tasks are distributed to worker threads in index order. The call returns
+ *  when all tasks have finished.
+ *
+ *  \param count The number of tasks.
+ *  \param task The task function, called once for each index [0, count).
+ *  \param threads The maximum number of threads, 0 for GetThreadCount().
+ */
+void ParallelFor(unsigned int count,
+    const std::function<void(unsigned int)>& task, unsigned int threads = 0);
+
+/*! \brief Runs tasks concurrently, printing their output in task order.
+ *
+ *  Works like ParallelFor(), but everything a task writes to std::cout is
+ *  buffered and printed after all tasks have finished, so messages of
+ *  concurrent tasks do not interleave.
+ *
+ *  \param count The number of tasks.
+ *  \param task The task function, called once for each index [0, count).
+ *  \param threads The maximum number of threads, 0 for GetThreadCount().
+ */
+void ParallelForBuffered(unsigned int count,
+    const std::function<void(unsigned int)>& task, unsigned int threads = 0);
+
+#endif
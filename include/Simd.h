@@ -0,0 +1,163 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+#include "Common.h"
+
+/*! \brief Instruction sets of the vector kernels.
+ */
+enum class SimdLevel
+{
+    SCALAR = 0,
+    SSE2,
+    AVX2, /*!< AVX2 with FMA. */
+    AVX512 /*!< AVX-512F. */
+};
+
+/*! \brief Returns the best instruction set supported by the processor.
+ *
+ *  \return The detected level (SCALAR on other than x86 processors).
+ */
+SimdLevel DetectSimdLevel();
+
+/*! \brief Returns the instruction set the kernels currently use.
+ *
+ *  \return The active level, DetectSimdLevel() by default.
+ */
+SimdLevel GetSimdLevel();
+
+/*! \brief Selects the instruction set of the kernels (e.g. for testing).
+ *
+ *  \param level The requested level, limited to DetectSimdLevel().
+ *
+ *  \return The level taken into use.
+ *
+ *  \note Not thread-safe, must not be called while kernels are in use.
+ */
+SimdLevel SetSimdLevel(SimdLevel level);
+
+/*! \brief Returns the name of an instruction set.
+ *
+ *  \param level The level.
+ *
+ *  \return The name (e.g. "AVX2").
+ */
+std::string GetSimdLevelName(SimdLevel level);
+
+/*! \brief Calculates a squared euclidean distance (scalar version).
+ *
+ *  \param a The first vector.
+ *  \param b The second vector.
+ *  \param size The number of values.
+ *
+ *  \return The squared euclidean distance.
+ */
+template<typename T>
+T VectorDistance(const T* a, const T* b, unsigned int size)
+{
+    T distance = T();
+
+    for (unsigned int i = 0; i < size; i++) {
+        T diff = a[i] - b[i];
+        distance += diff * diff;
+    }
+
+    return distance;
+}
+
+/*! \brief Adds b to a value by value (scalar version).
+ */
+template<typename T>
+void VectorAdd(T* a, const T* b, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; i++)
+        a[i] += b[i];
+}
+
+/*! \brief Subtracts b from a value by value (scalar version).
+ */
+template<typename T>
+void VectorSubtract(T* a, const T* b, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; i++)
+        a[i] -= b[i];
+}
+
+/*! \brief Multiplies a by b value by value (scalar version).
+ */
+template<typename T>
+void VectorMultiply(T* a, const T* b, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; i++)
+        a[i] *= b[i];
+}
+
+/*! \brief Divides a by b value by value (scalar version).
+ */
+template<typename T>
+void VectorDivide(T* a, const T* b, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; i++)
+        a[i] /= b[i];
+}
+
+/*! \brief Adds a matrix product to a matrix, c += a * b (scalar version).
+ *
+ *  The matrices are stored row by row: a has rows x inner values, b
+ *  inner x columns and c rows x columns.
+ */
+template<typename T>
+void MatrixMultiplyAdd(T* c, const T* a, const T* b, unsigned int rows,
+    unsigned int inner, unsigned int columns)
+{
+    for (unsigned int r = 0; r < rows; r++) {
+        T* output = c + r * columns;
+
+        for (unsigned int i = 0; i < inner; i++) {
+            T value = a[r * inner + i];
+            const T* row = b + i * columns;
+
+            for (unsigned int k = 0; k < columns; k++)
+                output[k] += value * row[k];
+        }
+    }
+}
+
+/*! \brief Vectorized versions of the kernels for float and double.
+ *
+ *  Dispatched to the active instruction set. Sums are accumulated in a
+ *  different order than in the scalar versions, results may differ in
+ *  rounding.
+ */
+float VectorDistance(const float* a, const float* b, unsigned int size);
+double VectorDistance(const double* a, const double* b, unsigned int size);
+void VectorAdd(float* a, const float* b, unsigned int size);
+void VectorAdd(double* a, const double* b, unsigned int size);
+void VectorSubtract(float* a, const float* b, unsigned int size);
+void VectorSubtract(double* a, const double* b, unsigned int size);
+void VectorMultiply(float* a, const float* b, unsigned int size);
+void VectorMultiply(double* a, const double* b, unsigned int size);
+void VectorDivide(float* a, const float* b, unsigned int size);
+void VectorDivide(double* a, const double* b, unsigned int size);
+void MatrixMultiplyAdd(float* c, const float* a, const float* b,
+    unsigned int rows, unsigned int inner, unsigned int columns);
+void MatrixMultiplyAdd(double* c, const double* a, const double* b,
+    unsigned int rows, unsigned int inner, unsigned int columns);
+
+/*! \brief Checks that the kernels of every supported level agree with
+ *  the scalar versions (sizes 1-80, float and double).
+ *
+ *  \return True if all the kernels agree, false otherwise.
+ */
+bool CheckSimdKernels();
+
+/*! \brief Prints the time per call of each kernel and supported level for
+ *  13, 26 and 39 dimensional vectors, and the throughput of the matrix
+ *  product.
+ */
+void BenchmarkSimdKernels();
+
+#endif
@@ -0,0 +1,90 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _SLIDINGCMVN_H_
+#define _SLIDINGCMVN_H_
+
+#include "Common.h"
+
+#include "DynamicVector.h"
+
+/*! \class SlidingCMVN
+ *  \brief Cepstral mean variance normalization over a sliding window.
+ *
+ *  Frames are normalized as they arrive using the mean and deviation of
+ *  the last window size frames (the current frame included), so no future
+ *  frames are needed. The statistics are kept as running sums, a new frame
+ *  is added and the oldest frame removed in constant time.
+ *
+ *  Until the window has two frames the deviation is undefined and frames
+ *  are only mean normalized.
+ */
+class SlidingCMVN
+{
+public:
+    /*! \brief Constructor.
+     *
+     *  \param dimensionCount The number of feature dimensions.
+     *  \param windowSize The window size in frames.
+     */
+    SlidingCMVN(unsigned int dimensionCount = 0,
+        unsigned int windowSize = DefaultWindowSize);
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~SlidingCMVN();
+
+    /*! \brief Start a new stream.
+     *
+     *  \param dimensionCount The number of feature dimensions.
+     *  \param windowSize The window size in frames.
+     */
+    void Reset(unsigned int dimensionCount,
+        unsigned int windowSize = DefaultWindowSize);
+
+    /*! \brief Add a frame to the window and normalize it.
+     *
+     *  \param frame Feature values (dimension count values), normalized in
+     *  place.
+     */
+    void Normalize(Real* frame);
+
+    /*! \brief Add a frame to the window and normalize it.
+     *
+     *  \param frame The feature vector, normalized in place.
+     */
+    void Normalize(DynamicVector<Real>& frame);
+
+    /*! \brief Returns the number of feature dimensions.
+     *
+     *  \return The number of dimensions.
+     */
+    unsigned int GetDimensionCount() const;
+
+    /*! \brief Returns the window size.
+     *
+     *  \return The window size in frames.
+     */
+    unsigned int GetWindowSize() const;
+
+public:
+    static const unsigned int DefaultWindowSize = 300; /*!< 3 s of 10 ms frames. */
+
+private:
+    std::vector<Real> mWindow; /*!< Original values of the frames in the window. */
+
+    std::vector<Accumulator> mSums;
+
+    std::vector<Accumulator> mSquares;
+
+    unsigned int mDimensionCount;
+
+    unsigned int mWindowSize;
+
+    unsigned int mCount; /*!< Number of frames in the window. */
+
+    unsigned int mPosition; /*!< Next frame slot in the window. */
+};
+
+#endif
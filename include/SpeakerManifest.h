@@ -0,0 +1,122 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _SPEAKERMANIFEST_H_
+#define _SPEAKERMANIFEST_H_
+
+#include "Common.h"
+
+#include <cstdint>
+
+/*! \brief Returns the path of the speaker manifest of a sample folder.
+ *
+ *  \param folder The sample folder.
+ *
+ *  \return The manifest path (folder/speakers.txt).
+ */
+std::string GetSpeakerManifestPath(const std::string& folder);
+
+/*! \class SpeakerManifest
+ *  \brief Speakers of a sample folder.
+ *
+ *  Lists the sample files (samples_N.txt) of a folder with the speaker id,
+ *  the number of feature vectors and the file size. Speakers are indexed
+ *  in file order starting at 1.
+ *
+ *  Manifest format, one line per sample file:
+ *  file number, speaker id, file name, frame count, byte size.
+ *  Lines starting with '#' are comments.
+ *
+ *  \note The manifest is not updated automatically if sample files are
+ *  added or changed, use Build() (sop -manifest folder).
+ */
+class SpeakerManifest
+{
+public:
+    struct Entry
+    {
+        unsigned int number; /*!< N in samples_N.txt */
+        std::string id; /*!< Speaker id (3 first characters of the labels). */
+        std::string file; /*!< File name relative to the folder. */
+        uint64_t frameCount; /*!< Number of feature vectors. */
+        uint64_t byteSize; /*!< File size. */
+    };
+
+public:
+    /*! \brief Default constructor.
+     */
+    SpeakerManifest();
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~SpeakerManifest();
+
+    /*! \brief Load a manifest file.
+     *
+     *  \param path Path to the manifest.
+     *
+     *  \return True if the manifest was loaded, false otherwise.
+     */
+    bool Load(const std::string& path);
+
+    /*! \brief Save the manifest.
+     *
+     *  \param path Path to the manifest.
+     *
+     *  \return True if the manifest was saved, false otherwise.
+     */
+    bool Save(const std::string& path) const;
+
+    /*! \brief Build the manifest by scanning the sample files of a folder.
+     *
+     *  Files are probed from samples_1.txt on; missing files are skipped up
+     *  to samples_109.txt (the original corpus), after that the first
+     *  missing file ends the scan.
+     *
+     *  \param folder The sample folder.
+     *
+     *  \return True if any sample files were found, false otherwise.
+     */
+    bool Build(const std::string& folder);
+
+    /*! \brief Check that the manifest matches the sample files of a folder.
+     *
+     *  \param folder The sample folder.
+     *
+     *  \return False if a listed file is missing or its size changed, or if
+     *  a sample file follows the last listed one, true otherwise.
+     */
+    bool IsCurrent(const std::string& folder) const;
+
+    /*! \brief Returns the number of speakers.
+     *
+     *  \return The number of speakers (sample files).
+     */
+    unsigned int GetSpeakerCount() const;
+
+    /*! \brief Returns a speaker entry.
+     *
+     *  \param index Speaker index (starts at 1).
+     *
+     *  \return The entry or nullptr if the index is out of range.
+     */
+    const Entry* GetEntry(unsigned int index) const;
+
+    /*! \brief Returns the manifest of a sample folder.
+     *
+     *  The manifest is loaded once per folder. If the manifest file is
+     *  missing or out of date (see IsCurrent()) it is built and saved.
+     *  Thread-safe.
+     *
+     *  \param folder The sample folder.
+     *
+     *  \return The manifest (empty if the folder has no sample files).
+     */
+    static std::shared_ptr<const SpeakerManifest> Get(const std::string& folder);
+
+private:
+    std::vector<Entry> mEntries;
+};
+
+#endif
@@ -8,33 +8,48 @@
 #include "Common.h"
 
 #include "DynamicVector.h"
+#include "FeatureMatrix.h"
 
 #include "SpeakerKey.h"
 
-#include <streambuf>
-
 class SpeechData;
 
 void LoadTextSamples(const std::string& folder, const std::shared_ptr<SpeechData>& data, unsigned int sf, unsigned int gf, unsigned int sl, unsigned int gl, unsigned int multiplier, bool train);
 
 std::string GetSpeakerString(unsigned int index, const std::string& folder);
 
-struct SpeechDataBuffer : public std::streambuf
-{
-    SpeechDataBuffer(char* b, std::size_t s)
-    {
-        setg(b, b, b + s);
-    }
-};
-
 enum class FeatureNormalizationType
 {
     NONE = 0,
-    CEPSTRAL_MEAN_VARIANCE
+    CEPSTRAL_MEAN_VARIANCE,
+    SLIDING_CEPSTRAL_MEAN_VARIANCE
 };
 
+/*! \brief Parses a sample folder name (folder_fN_deltas_vad_cmvn or
+ *  folder_fN_deltas_vad_scmvn).
+ *
+ *  \param folder The folder name.
+ *  \param baseFolder The actual folder.
+ *  \param maxFeatures Maximum number of features (39 if not specified).
+ *  \param normalizationType Requested normalization (cmvn: utterance based,
+ *  scmvn: sliding window, NONE if not specified).
+ *  \param computeDeltas True if the folder stores only the static
+ *  coefficients and deltas are calculated when loading (deltas).
+ *  \param removeSilence True if silent frames are removed when loading
+ *  (vad).
+ *
+ *  \return True if the folder name is valid, false otherwise.
+ */
+bool ParseSamplesFolder(const std::string& folder, std::string& baseFolder,
+    unsigned int& maxFeatures, FeatureNormalizationType& normalizationType,
+    bool& computeDeltas, bool& removeSilence);
+
 /*! \class SpeechData
  *  \brief A container for speech data of multiple speakers.
+ *
+ *  Feature vectors of all speakers are stored in a single contiguous
+ *  matrix, speaker samples are views to its rows. Copies share the matrix
+ *  until either one is modified.
  */
 class SpeechData
 {
@@ -43,10 +58,35 @@ public:
      */
     SpeechData();
 
+    /*! \brief Copy constructor.
+     *
+     *  \param other The data set to be copied.
+     */
+    SpeechData(const SpeechData& other);
+
+    /*! \brief Creates a view to the first dimensions of another data set.
+     *
+     *  The frames are shared, e.g. 13 and 26 dimensional feature sets can
+     *  be taken from loaded 39 dimensional features.
+     *
+     *  \param other The data set to be viewed.
+     *  \param dimensionCount The number of dimensions (from the beginning of
+     *  the feature vectors).
+     */
+    SpeechData(const SpeechData& other, unsigned int dimensionCount);
+
     /*! \brief Virtual destructor.
      */
     virtual ~SpeechData();
 
+    /*! \brief Copy assignment operator.
+     *
+     *  \param other The data set to be copied.
+     *
+     *  \return Reference to this data set.
+     */
+    SpeechData& operator= (const SpeechData& other);
+
     /*! \brief Loads speech data from a text file. (Old version).
      *
      *  \param path Path to a file containing speaker-specific speech data.
@@ -71,6 +111,46 @@ public:
         unsigned multiplier, bool train, unsigned int maxFeatures,
         bool normalize = false, const std::string& alias = "");
 
+    /*! \brief Loads speech data from a binary feature file.
+     *
+     *  Utterances of the binary file correspond to the lines of the text
+     *  file it was converted from, all parameters work the same way as in
+     *  the text version.
+     *
+     *  \param path Path to a binary feature file.
+     *  \param sourcePath Path to the text file the binary file was converted
+     *  from, empty to skip the up-to-date check.
+     *
+     *  \return True if the binary file was loaded, false if it could not be
+     *  opened or is out of date (nothing is loaded in that case).
+     *
+     *  \see Load(), ConvertTextSamples(), FeatureFile::Open()
+     */
+    bool LoadBinary(const std::string& path, const std::string& sourcePath,
+        unsigned int sl, unsigned int gl, unsigned multiplier, bool train,
+        unsigned int maxFeatures, bool normalize = false,
+        const std::string& alias = "");
+
+    /*! \brief Adds an utterance (e.g. computed by a front-end).
+     *
+     *  \param key The speaker key.
+     *  \param frames The feature vectors of the utterance.
+     *
+     *  \note Validate() must be called after adding utterances.
+     */
+    void AddUtterance(const SpeakerKey& key, const FeatureMatrix& frames);
+
+    /*! \brief Moves all samples of another data set to this data set.
+     *
+     *  Samples of speakers found in both data sets are appended after
+     *  the existing samples. The other data set will be cleared.
+     *
+     *  \param other The data set to be merged.
+     *
+     *  \note Validate() must be called after merging.
+     */
+    void Merge(SpeechData& other);
+
     /*! \brief Validates loaded data.
      *
      *  Checks that data dimensions match.
@@ -117,6 +197,20 @@ public:
         std::vector < DynamicVector<Real> >::iterator beginIt,
         std::vector < DynamicVector<Real> >::iterator endIt);
 
+    /*! \brief Normalize selected samples using Ceptstral Mean Variance
+     *  Normalization over a sliding window.
+     *
+     *  The samples are processed in order as a stream.
+     *
+     *  \param beginIt Begin iterator of the samples to be normalized.
+     *  \param endIt End iterator of the samples to be normalized.
+     *
+     *  \see SlidingCMVN, SetNormalizationWindow().
+     */
+    void SlidingWindowCMVN(
+        std::vector < DynamicVector<Real> >::iterator beginIt,
+        std::vector < DynamicVector<Real> >::iterator endIt);
+
     /*! \brief Normalize selected samples using a predefined normalization type.
     *
      *  \param beginIt Begin iterator of the samples to be normalized.
@@ -142,6 +236,53 @@ public:
      */
     FeatureNormalizationType GetNormalizationType() const;
 
+    /*! \brief Sets the window size of sliding window normalization.
+     *
+     *  \param windowSize The window size in frames.
+     */
+    void SetNormalizationWindow(unsigned int windowSize);
+
+    /*! \brief Gets the window size of sliding window normalization.
+     *
+     *  \return The window size in frames.
+     */
+    unsigned int GetNormalizationWindow() const;
+
+    /*! \brief Enables calculating deltas when loading.
+     *
+     *  The loaded feature vectors are taken as static coefficients and
+     *  extended with deltas and delta-deltas (per utterance) up to the
+     *  maximum number of features.
+     *
+     *  \param computeDeltas True to calculate deltas.
+     *
+     *  \see AddDeltas()
+     */
+    void SetComputeDeltas(bool computeDeltas);
+
+    /*! \brief Checks if deltas are calculated when loading.
+     *
+     *  \return True if deltas are calculated, false otherwise.
+     */
+    bool GetComputeDeltas() const;
+
+    /*! \brief Enables removing silent frames when loading.
+     *
+     *  The first feature is taken as the log frame energy, low energy
+     *  frames of each utterance are discarded.
+     *
+     *  \param removeSilence True to remove silent frames.
+     *
+     *  \see RemoveSilentFrames()
+     */
+    void SetRemoveSilence(bool removeSilence);
+
+    /*! \brief Checks if silent frames are removed when loading.
+     *
+     *  \return True if silent frames are removed, false otherwise.
+     */
+    bool GetRemoveSilence() const;
+
     /*! \brief Returns the number of loaded speakers.
      *
      *  \return The number of loaded speakers.
@@ -161,11 +302,110 @@ public:
     const std::map<SpeakerKey, std::vector<DynamicVector<Real> > >&
     GetSamples() const;
 
+    /*! \brief Returns samples of all speakers (in speaker key order).
+     *
+     *  \return Views to all loaded samples.
+     *
+     *  \note The views are invalidated when data is loaded, merged or
+     *  cleared.
+     */
+    std::vector< DynamicVector<Real> > GetAllSamples();
+
+private:
+    struct Utterance
+    {
+        unsigned int begin; /*!< First row. */
+        unsigned int end; /*!< One past the last row. */
+    };
+
+    /*! \brief Append feature vectors to the frame matrix.
+     *
+     *  The first appended vector sets the number of dimensions, vectors
+     *  of a different size are discarded and mark the data inconsistent.
+     *
+     *  \param values Pointer to the first feature of the first vector.
+     *  \param count The number of vectors.
+     *  \param size The number of features per vector.
+     *  \param stride Distance between vectors, 0 if they are packed.
+     */
+    template<typename T>
+    void AppendFrames(const T* values, unsigned int count, unsigned int size,
+        unsigned int stride = 0);
+
+    /*! \brief Append a feature vector to the frame matrix.
+     *
+     *  \see AppendFrames().
+     */
+    template<typename T>
+    void AppendFrame(const T* values, unsigned int size);
+
+    /*! \brief Append the static coefficients of an utterance extended
+     *  with deltas.
+     *
+     *  \param maxFeatures The number of features to append per vector
+     *  (at most three times the size).
+     *
+     *  \see AppendFrames(), SetComputeDeltas().
+     */
+    template<typename T>
+    void AppendDeltaFrames(const T* values, unsigned int count,
+        unsigned int size, unsigned int stride, unsigned int maxFeatures);
+
+    /*! \brief Add an utterance (a range of frame rows) to a speaker.
+     *
+     *  \param key The speaker key.
+     *  \param begin First row of the utterance.
+     *  \param end One past the last row of the utterance.
+     *
+     *  \return True if the speaker has samples, false otherwise.
+     */
+    bool AppendUtterance(const SpeakerKey& key, unsigned int begin,
+        unsigned int end);
+
+    /*! \brief Remove silent frames from the end of the frame matrix.
+     *
+     *  \param begin First row of the utterance (rows up to the end).
+     *
+     *  \return One past the last remaining row.
+     */
+    unsigned int RemoveSilence(unsigned int begin);
+
+    /*! \brief Normalize a range of frame rows.
+     *
+     *  \param beginRow First row.
+     *  \param endRow One past the last row.
+     */
+    void Normalize(unsigned int beginRow, unsigned int endRow);
+
+    /*! \brief Make a private copy of the frame matrix if it is shared.
+     *
+     *  \note Views must be updated afterwards.
+     */
+    void DetachFrames();
+
+    /*! \brief Rebuild speaker sample views after the frame matrix changed.
+     */
+    void UpdateSamples();
+
 private:
     FeatureNormalizationType mNormalizationType;
 
+    unsigned int mNormalizationWindow;
+
+    bool mComputeDeltas;
+
+    bool mRemoveSilence;
+
+    std::shared_ptr<FeatureMatrix> mFrames;
+
+    std::map<SpeakerKey, std::vector<Utterance> > mUtterances;
+
+    unsigned int mSampleDimensionCount; /*!< Dimensions in views, 0 for all. */
+
     std::map<SpeakerKey, std::vector<DynamicVector<Real> > > mSamples;
 
+    bool mFrameSizeMismatch;
+
     bool mConsistent;
 
     unsigned int mDimensionCount;
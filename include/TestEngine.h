@@ -48,6 +48,7 @@ private:
         std::string features = "";
 
         bool weighting = false;
+        unsigned int selection = 0;
         bool ubm = false;
         ScoreNormalizationType scoreNormalizationType = ScoreNormalizationType::NONE;
         unsigned int order = 1;
@@ -115,12 +116,47 @@ private:
         std::shared_ptr<ModelRecognizer> recognizer);
 
 private:
+    /*! \brief Loads speech data for a test.
+     *
+     *  Data is loaded once per folder (and normalization) using the widest feature
+     *  set of the tests, narrower feature sets are views to the same data.
+     *  Train data is kept until the folder changes, only the most recently
+     *  used test data sets are kept.
+     *
+     *  \see LoadTextSamples().
+     */
+    std::shared_ptr<SpeechData> LoadSamples(const std::string& features,
+        unsigned int sf, unsigned int gf, unsigned int sl, unsigned int gl,
+        unsigned int multiplier, bool train);
+
+    /*! \brief Returns the key of loaded data shared by feature sets.
+     *
+     *  \param baseFolder The actual folder.
+     *  \param normalizationType The feature normalization type.
+     *  \param computeDeltas True if deltas are calculated when loading.
+     *  \param removeSilence True if silent frames are removed when loading.
+     *
+     *  \return The key (also the folder name of the normalized data).
+     */
+    std::string GetSamplesKey(const std::string& baseFolder,
+        FeatureNormalizationType normalizationType, bool computeDeltas,
+        bool removeSilence);
+
     /*! \brief Labels a test instruction.
      *
      *  \return A user specified test label (if defined) or
      *  an automatically generated label (otherwise).
      */
     std::string GetLabel(const Test& test);
+
+private:
+    std::map<std::string, unsigned int> mFeatureCounts; /*!< Widest feature set per folder. */
+
+    std::map<std::string, std::shared_ptr<SpeechData> > mSamples; /*!< Loaded data of the current folder. */
+
+    std::vector<std::string> mTestSamples; /*!< Keys of cached test data, most recently used first. */
+
+    std::string mSamplesFolder;
 };
 
 #endif
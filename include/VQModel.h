@@ -11,6 +11,7 @@
 
 #include "DynamicVector.h"
 #include "LBG.h"
+#include "MemoryPool.h"
 #include "Model.h"
 
 /*! \brief Speaker recognizer based on Vector Quantization using LBG
@@ -108,12 +109,24 @@ public:
      */
     virtual unsigned int GetDimensionCount() const override;
 
+private:
+    /*! \brief Allocate the centroids from the memory pool.
+     *
+     *  Releases the previous centroids, all values are zero.
+     *
+     *  \param count The number of centroids.
+     *  \param dimensions The number of feature dimensions.
+     */
+    void AllocateCentroids(unsigned int count, unsigned int dimensions);
+
 private:
     std::vector< DynamicVector<Real> > mClusterCentroids;
     std::vector<unsigned int> mClusterSizes;
     std::vector<Real> mClusterWeights;
 
     mutable std::vector<unsigned int> mClusterSamples;
+
+    MemoryPool mPool; /*!< Storage of the centroids. */
 };
 
 #endif
@@ -0,0 +1,229 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _VECTOREXPRESSION_H_
+#define _VECTOREXPRESSION_H_
+
+#include "Common.h"
+
+#include <type_traits>
+
+/*! \brief Base of lazily evaluated vector expressions.
+ *
+ *  Vector arithmetic (+, - and value by value * and / of vectors, scaling
+ *  by a scalar) builds a small expression object instead of a result
+ *  vector. Assigning the expression to a DynamicVector evaluates it in a
+ *  single loop without temporary vectors, e.g.
+ *
+ *      centroid = w * centroid + (1.0f - w) * ubmCentroid;
+ *
+ *  Each value of the result only depends on the same values of the
+ *  operands, so the assigned vector can appear in the expression.
+ *
+ *  \note Expressions refer to their operands, evaluate them within the
+ *  same statement (do not store them, e.g. with auto).
+ *
+ *  \tparam E The expression type.
+ */
+template<typename E>
+class VectorExpression
+{
+public:
+    /*! \brief Returns the actual expression.
+     */
+    const E& GetExpression() const
+    {
+        return static_cast<const E&>(*this);
+    }
+};
+
+/*! \brief A scalar operand of a vector expression.
+ */
+template<typename S>
+class VectorScalar : public VectorExpression< VectorScalar<S> >
+{
+public:
+    typedef S ValueType;
+
+    explicit VectorScalar(S value)
+        : mValue(value)
+    {
+
+    }
+
+    /*! \brief Returns zero, a scalar fits vectors of any size.
+     */
+    unsigned int GetSize() const
+    {
+        return 0;
+    }
+
+    S operator[] (unsigned int) const
+    {
+        return mValue;
+    }
+
+private:
+    S mValue;
+};
+
+/*! \brief Operands are stored as references, scalars as values.
+ */
+template<typename E>
+struct VectorOperand
+{
+    typedef const E& Type;
+};
+
+template<typename S>
+struct VectorOperand< VectorScalar<S> >
+{
+    typedef VectorScalar<S> Type;
+};
+
+struct VectorPlus
+{
+    template<typename X, typename Y>
+    static auto Apply(X x, Y y) -> decltype(x + y)
+    {
+        return x + y;
+    }
+};
+
+struct VectorMinus
+{
+    template<typename X, typename Y>
+    static auto Apply(X x, Y y) -> decltype(x - y)
+    {
+        return x - y;
+    }
+};
+
+struct VectorTimes
+{
+    template<typename X, typename Y>
+    static auto Apply(X x, Y y) -> decltype(x * y)
+    {
+        return x * y;
+    }
+};
+
+struct VectorOver
+{
+    template<typename X, typename Y>
+    static auto Apply(X x, Y y) -> decltype(x / y)
+    {
+        return x / y;
+    }
+};
+
+/*! \brief A value by value operation of two operands.
+ *
+ *  The value type follows the usual arithmetic conversions, e.g. float
+ *  values scaled by a double are calculated in double precision.
+ */
+template<typename A, typename B, typename Operation>
+class VectorBinaryExpression
+    : public VectorExpression< VectorBinaryExpression<A, B, Operation> >
+{
+public:
+    typedef decltype(Operation::Apply(std::declval<typename A::ValueType>(),
+        std::declval<typename B::ValueType>())) ValueType;
+
+    VectorBinaryExpression(const A& a, const B& b)
+        : mA(a), mB(b)
+    {
+
+    }
+
+    unsigned int GetSize() const
+    {
+        return Max(mA.GetSize(), mB.GetSize());
+    }
+
+    ValueType operator[] (unsigned int index) const
+    {
+        return Operation::Apply(mA[index], mB[index]);
+    }
+
+private:
+    typename VectorOperand<A>::Type mA;
+
+    typename VectorOperand<B>::Type mB;
+};
+
+/*! \brief Vector addition.
+ */
+template<typename A, typename B>
+VectorBinaryExpression<A, B, VectorPlus> operator+ (
+    const VectorExpression<A>& a, const VectorExpression<B>& b)
+{
+    return VectorBinaryExpression<A, B, VectorPlus>(
+        a.GetExpression(), b.GetExpression());
+}
+
+/*! \brief Vector subtraction.
+ */
+template<typename A, typename B>
+VectorBinaryExpression<A, B, VectorMinus> operator- (
+    const VectorExpression<A>& a, const VectorExpression<B>& b)
+{
+    return VectorBinaryExpression<A, B, VectorMinus>(
+        a.GetExpression(), b.GetExpression());
+}
+
+/*! \brief Value by value multiplication.
+ */
+template<typename A, typename B>
+VectorBinaryExpression<A, B, VectorTimes> operator* (
+    const VectorExpression<A>& a, const VectorExpression<B>& b)
+{
+    return VectorBinaryExpression<A, B, VectorTimes>(
+        a.GetExpression(), b.GetExpression());
+}
+
+/*! \brief Value by value division.
+ */
+template<typename A, typename B>
+VectorBinaryExpression<A, B, VectorOver> operator/ (
+    const VectorExpression<A>& a, const VectorExpression<B>& b)
+{
+    return VectorBinaryExpression<A, B, VectorOver>(
+        a.GetExpression(), b.GetExpression());
+}
+
+/*! \brief Scaling by a scalar (scalar * vector).
+ */
+template<typename S, typename E>
+typename std::enable_if<std::is_arithmetic<S>::value,
+    VectorBinaryExpression<VectorScalar<S>, E, VectorTimes> >::type
+operator* (S scalar, const VectorExpression<E>& e)
+{
+    return VectorBinaryExpression<VectorScalar<S>, E, VectorTimes>(
+        VectorScalar<S>(scalar), e.GetExpression());
+}
+
+/*! \brief Scaling by a scalar (vector * scalar).
+ */
+template<typename E, typename S>
+typename std::enable_if<std::is_arithmetic<S>::value,
+    VectorBinaryExpression<E, VectorScalar<S>, VectorTimes> >::type
+operator* (const VectorExpression<E>& e, S scalar)
+{
+    return VectorBinaryExpression<E, VectorScalar<S>, VectorTimes>(
+        e.GetExpression(), VectorScalar<S>(scalar));
+}
+
+/*! \brief Division by a scalar.
+ */
+template<typename E, typename S>
+typename std::enable_if<std::is_arithmetic<S>::value,
+    VectorBinaryExpression<E, VectorScalar<S>, VectorOver> >::type
+operator/ (const VectorExpression<E>& e, S scalar)
+{
+    return VectorBinaryExpression<E, VectorScalar<S>, VectorOver>(
+        e.GetExpression(), VectorScalar<S>(scalar));
+}
+
+#endif
@@ -0,0 +1,162 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _VOICEACTIVITYDETECTOR_H_
+#define _VOICEACTIVITYDETECTOR_H_
+
+#include "Common.h"
+
+/*! \brief Log energy range of voiced feature frames (about 30 dB).
+ *
+ *  \see RemoveSilentFrames()
+ */
+const Real VoiceActivityRange = 6.9f;
+
+/*! \class VoiceActivityDetector
+ *  \brief Energy based voice activity detection of a sample stream.
+ *
+ *  Works like scripts/silence_remover.py: the signal is split into
+ *  non-overlapping frames and frames with a mean squared amplitude below
+ *  the threshold are considered silent. Optionally a number of frames
+ *  after a voiced frame are kept regardless of their energy (hangover).
+ *
+ *  Samples can be processed in arbitrary sized blocks, a frame spanning
+ *  two blocks is buffered.
+ */
+class VoiceActivityDetector
+{
+public:
+    /*! \brief Constructor.
+     *
+     *  \param sampleRate The sample rate (Hz).
+     *  \param threshold Minimum mean squared amplitude of a voiced frame.
+     *  \param hangover Number of frames kept after a voiced frame.
+     */
+    VoiceActivityDetector(unsigned int sampleRate = 0,
+        Real threshold = DefaultThreshold, unsigned int hangover = 0);
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~VoiceActivityDetector();
+
+    /*! \brief Start a new stream.
+     *
+     *  \param sampleRate The sample rate (Hz).
+     */
+    void Reset(unsigned int sampleRate);
+
+    /*! \brief Set the energy threshold.
+     *
+     *  \param threshold Minimum energy of a voiced frame.
+     */
+    void SetThreshold(Real threshold);
+
+    /*! \brief Get the energy threshold.
+     *
+     *  \return The minimum energy of a voiced frame.
+     */
+    Real GetThreshold() const;
+
+    /*! \brief Set the hangover.
+     *
+     *  \param hangover Number of frames kept after a voiced frame.
+     */
+    void SetHangover(unsigned int hangover);
+
+    /*! \brief Get the hangover.
+     *
+     *  \return Number of frames kept after a voiced frame.
+     */
+    unsigned int GetHangover() const;
+
+    /*! \brief Returns the frame length.
+     *
+     *  \return The frame length in samples.
+     */
+    unsigned int GetFrameLength() const;
+
+    /*! \brief Classifies the next frame of the stream.
+     *
+     *  \param energy The energy of the frame.
+     *
+     *  \return True if the frame is kept, false if it is silent.
+     */
+    bool IsActive(Accumulator energy);
+
+    /*! \brief Process a block of samples.
+     *
+     *  \param samples The samples.
+     *  \param count The number of samples.
+     *  \param output Samples of voiced frames are appended to this vector.
+     */
+    void Process(const Real* samples, unsigned int count,
+        std::vector<Real>& output);
+
+    /*! \brief Process the buffered samples at the end of the stream.
+     *
+     *  The last frame may be shorter than the frame length.
+     *
+     *  \param output Samples of a voiced frame are appended to this vector.
+     */
+    void Flush(std::vector<Real>& output);
+
+    /*! \brief Returns the number of classified frames.
+     *
+     *  \return The number of frames.
+     */
+    unsigned int GetFrameCount() const;
+
+    /*! \brief Returns the number of kept frames.
+     *
+     *  \return The number of voiced (and hangover) frames.
+     */
+    unsigned int GetActiveFrameCount() const;
+
+public:
+    static const unsigned int DefaultThreshold = 30000; /*!< TRESHOLD of the script. */
+
+    static const unsigned int DefaultFrameDuration = 25; /*!< Frame length (ms). */
+
+private:
+    /*! \brief Classify a frame and keep it if voiced.
+     */
+    void ProcessFrame(const Real* samples, unsigned int count,
+        std::vector<Real>& output);
+
+private:
+    Real mThreshold;
+
+    unsigned int mHangover;
+
+    unsigned int mFrameLength;
+
+    std::vector<Real> mBuffer; /*!< Samples of an incomplete frame. */
+
+    unsigned int mRemaining; /*!< Hangover frames left. */
+
+    unsigned int mFrameCount;
+
+    unsigned int mActiveFrameCount;
+};
+
+/*! \brief Removes silent feature vectors of an utterance.
+ *
+ *  The first coefficient is taken as the log frame energy (as with MFCCs).
+ *  Frames with a log energy more than the range below the highest log
+ *  energy of the utterance are silent. The remaining frames are moved to
+ *  the beginning in order.
+ *
+ *  \param frames The first value of the first frame.
+ *  \param count The number of frames.
+ *  \param stride Distance between frames.
+ *  \param range The log energy range of voiced frames.
+ *  \param hangover Number of frames kept after a voiced frame.
+ *
+ *  \return The number of remaining frames.
+ */
+unsigned int RemoveSilentFrames(Real* frames, unsigned int count,
+    unsigned int stride, Real range = VoiceActivityRange,
+    unsigned int hangover = 0);
+
+#endif
@@ -0,0 +1,133 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#ifndef _WAVEFILE_H_
+#define _WAVEFILE_H_
+
+#include "Common.h"
+
+#include "MappedFile.h"
+
+#include <cstdint>
+
+/*! \class WaveFile
+ *  \brief A memory-mapped WAV (RIFF) audio file.
+ *
+ *  Supports PCM (8, 16, 24 and 32 bit) and IEEE float (32 and 64 bit)
+ *  samples. The sample data is accessed directly from the mapping, samples
+ *  are only converted when read, a range at a time, so long recordings can
+ *  be processed in chunks with bounded memory.
+ *
+ *  Read samples are in the 16-bit range regardless of the format (as
+ *  16-bit values read by the python scripts) and channels are averaged.
+ */
+class WaveFile
+{
+public:
+    enum class SampleFormat
+    {
+        PCM = 1,
+        IEEE_FLOAT = 3
+    };
+
+public:
+    /*! \brief Default constructor.
+     */
+    WaveFile();
+
+    /*! \brief Virtual destructor.
+     */
+    virtual ~WaveFile();
+
+    /*! \brief Open a WAV file.
+     *
+     *  \param path Path to the file.
+     *
+     *  \return True if the file was opened and the format is supported,
+     *  false otherwise.
+     */
+    bool Open(const std::string& path);
+
+    /*! \brief Close the file.
+     */
+    void Close();
+
+    /*! \brief Check if a file is open.
+     *
+     *  \return True if a file is open, false otherwise.
+     */
+    bool IsOpen() const;
+
+    /*! \brief Returns the sample rate.
+     *
+     *  \return The sample rate (Hz).
+     */
+    unsigned int GetSampleRate() const;
+
+    /*! \brief Returns the number of channels.
+     *
+     *  \return The number of channels.
+     */
+    unsigned int GetChannelCount() const;
+
+    /*! \brief Returns the sample format.
+     *
+     *  \return The sample format.
+     */
+    SampleFormat GetSampleFormat() const;
+
+    /*! \brief Returns the sample size.
+     *
+     *  \return The number of bits per sample.
+     */
+    unsigned int GetBitsPerSample() const;
+
+    /*! \brief Returns the length of the recording.
+     *
+     *  \return The number of samples per channel.
+     */
+    unsigned int GetLength() const;
+
+    /*! \brief Returns the raw sample data.
+     *
+     *  Samples of all channels interleaved, GetBitsPerSample() bits each,
+     *  little-endian.
+     *
+     *  \return Pointer to the first sample in the mapping.
+     */
+    const char* GetSampleData() const;
+
+    /*! \brief Read and convert samples.
+     *
+     *  \param first Index of the first sample (per channel).
+     *  \param count The number of samples to read.
+     *  \param output Converted samples (count values).
+     *
+     *  \return The number of samples read (less than count at the end).
+     */
+    unsigned int Read(unsigned int first, unsigned int count,
+        Real* output) const;
+
+private:
+    /*! \brief Returns a sample of a channel in the 16-bit range.
+     */
+    Real GetSample(const unsigned char* data) const;
+
+private:
+    MappedFile mFile;
+
+    const char* mSamples;
+
+    unsigned int mLength;
+
+    unsigned int mSampleRate;
+
+    unsigned int mChannelCount;
+
+    unsigned int mBitsPerSample;
+
+    SampleFormat mSampleFormat;
+};
+
+#endif
@@ -0,0 +1,247 @@
+'''
+Writes a test wave file and reference features for comparing the native
+front-ends with the python ones (sop -frontend compare).
+
+Usage: frontend_reference.py [mfcc|lpc|lpcc] seconds wavefile reference
+
+References (the one used is printed with its frames/s):
+- mfcc: features.mfcc (python_speech_features, as in feature_extractor.py)
+  when it is installed, otherwise a pure python port of it (same defaults:
+  25 ms / 10 ms frames, 512-point FFT, 26 filters, 13 coefficients,
+  pre-emphasis 0.97, lifter 22, c0 replaced by the log frame energy).
+- lpc: scikits.talkbox lpc() on features.sigproc.framesig frames, order 12,
+  as get_lpcc() in feature_extractor.py, when both are installed. Otherwise
+  a pure python port of framesig and of talkbox's biased autocorrelation
+  and Levinson-Durbin recursion.
+- lpcc: no python implementation exists (feature_extractor.py writes the
+  lpc polynomial). The cepstrum of the all-pole model is computed
+  numerically from log(e / |A(e^jw)|^2) with a 4096-point FFT, independent
+  of the recursion used by the native code. c0 is log(e).
+'''
+from __future__ import division, print_function
+
+import cmath
+import math
+import struct
+import sys
+import time
+import wave
+
+SAMPLE_RATE = 16000
+EPSILON = 2.220446049250313e-16 # numpy.finfo(float).eps
+
+
+def generate_signal(length, rate):
+    '''
+    two tones and uniform noise in the 16-bit range (as in the C++ benchmark)
+    '''
+    signal = []
+    noise = 12345
+    for i in range(length):
+        t = i / rate
+        noise = (noise * 1103515245 + 12345) & 0xffffffff
+        signal.append(int(math.floor(5000.0 * math.sin(2.0 * math.pi * 300.0 * t)
+            + 2000.0 * math.sin(2.0 * math.pi * 2100.0 * t)
+            + ((noise >> 16) % 1001) - 500.0)))
+    return signal
+
+
+def write_wave(path, signal, rate):
+    out = wave.open(path, 'wb')
+    out.setnchannels(1)
+    out.setsampwidth(2)
+    out.setframerate(rate)
+    out.writeframes(b''.join(struct.pack('<h', x) for x in signal))
+    out.close()
+
+
+def round_half_up(value):
+    return int(math.floor(value + 0.5))
+
+
+def framesig(signal, frame_len, frame_step):
+    '''
+    port of features.sigproc.framesig (rectangular window, zero padded)
+    '''
+    frame_len = round_half_up(frame_len)
+    frame_step = round_half_up(frame_step)
+    length = len(signal)
+    if length <= frame_len:
+        count = 1
+    else:
+        count = 1 + int(math.ceil((length - frame_len) / frame_step))
+    padded = list(signal) + [0.0] * ((count - 1) * frame_step + frame_len - length)
+    return [padded[i * frame_step:i * frame_step + frame_len] for i in range(count)]
+
+
+def fft(values):
+    '''
+    recursive radix-2 FFT of a complex list (length a power of two)
+    '''
+    n = len(values)
+    if n == 1:
+        return list(values)
+    even = fft(values[0::2])
+    odd = fft(values[1::2])
+    result = [0j] * n
+    for k in range(n // 2):
+        twiddle = cmath.exp(-2j * math.pi * k / n) * odd[k]
+        result[k] = even[k] + twiddle
+        result[k + n // 2] = even[k] - twiddle
+    return result
+
+
+def powspec(frame, nfft):
+    '''
+    port of features.sigproc.powspec for a single frame
+    '''
+    data = [complex(x) for x in frame[:nfft]] + [0j] * max(0, nfft - len(frame))
+    spectrum = fft(data)
+    return [abs(spectrum[i]) ** 2 / nfft for i in range(nfft // 2 + 1)]
+
+
+def hz2mel(hz):
+    return 2595 * math.log10(1 + hz / 700.0)
+
+
+def mel2hz(mel):
+    return 700 * (10 ** (mel / 2595.0) - 1)
+
+
+def get_filterbanks(nfilt, nfft, rate, lowfreq, highfreq):
+    lowmel = hz2mel(lowfreq)
+    highmel = hz2mel(highfreq)
+    points = [lowmel + i * (highmel - lowmel) / (nfilt + 1) for i in range(nfilt + 2)]
+    points[-1] = highmel
+    bins = [math.floor((nfft + 1) * mel2hz(p) / rate) for p in points]
+    bank = [[0.0] * (nfft // 2 + 1) for j in range(nfilt)]
+    for j in range(nfilt):
+        for i in range(int(bins[j]), int(bins[j + 1])):
+            bank[j][i] = (i - bins[j]) / (bins[j + 1] - bins[j])
+        for i in range(int(bins[j + 1]), int(bins[j + 2])):
+            bank[j][i] = (bins[j + 2] - i) / (bins[j + 2] - bins[j + 1])
+    return bank
+
+
+def mfcc_port(signal, rate, winlen=0.025, winstep=0.01, numcep=13, nfilt=26,
+        nfft=512, lowfreq=0, highfreq=None, preemph=0.97, ceplifter=22,
+        append_energy=True):
+    '''
+    pure python port of features.mfcc
+    '''
+    highfreq = highfreq or rate / 2
+    emphasized = [float(signal[0])] + [signal[i] - preemph * signal[i - 1]
+        for i in range(1, len(signal))]
+    bank = get_filterbanks(nfilt, nfft, rate, lowfreq, highfreq)
+    result = []
+    for frame in framesig(emphasized, winlen * rate, winstep * rate):
+        power = powspec(frame, nfft)
+        energy = sum(power) or EPSILON
+        energies = [math.log(sum(w * p for w, p in zip(weights, power)) or EPSILON)
+            for weights in bank]
+        coefficients = []
+        for k in range(numcep):
+            scale = math.sqrt((1.0 if k == 0 else 2.0) / nfilt)
+            value = scale * sum(energies[n] * math.cos(math.pi * k * (2 * n + 1) / (2.0 * nfilt))
+                for n in range(nfilt))
+            if ceplifter > 0:
+                # integer division as in python 2
+                value *= 1 + (ceplifter // 2) * math.sin(math.pi * k / ceplifter)
+            coefficients.append(value)
+        if append_energy:
+            coefficients[0] = math.log(energy)
+        result.append(coefficients)
+    return result
+
+
+def lpc_port(frame, order):
+    '''
+    pure python port of talkbox lpc(): biased autocorrelation and the
+    Levinson-Durbin recursion, returns (polynomial, prediction error)
+    '''
+    length = len(frame)
+    r = [sum(frame[i] * frame[i - lag] for i in range(lag, length)) / length
+        for lag in range(order + 1)]
+    a = [1.0] + [0.0] * order
+    error = r[0]
+    for i in range(1, order + 1):
+        if error <= 0.0:
+            break
+        k = -(r[i] + sum(a[j] * r[i - j] for j in range(1, i))) / error
+        previous = a[:]
+        for j in range(1, i):
+            a[j] = previous[j] + k * previous[i - j]
+        a[i] = k
+        error *= 1.0 - k * k
+    return a, error
+
+
+def lpc_frames(signal, rate, order=12):
+    return [lpc_port([float(x) for x in frame], order)
+        for frame in framesig(signal, 0.025 * rate, 0.01 * rate)]
+
+
+def lpcc_numeric(polynomial, error, count=13, size=4096):
+    '''
+    cepstrum of 1 / A(z) from the log power spectrum, with c0 = log(error)
+    '''
+    spectrum = fft([complex(x) for x in polynomial] + [0j] * (size - len(polynomial)))
+    logs = fft([complex(math.log(max(error, EPSILON) / abs(x) ** 2)) for x in spectrum])
+    return [math.log(max(error, EPSILON))] + [logs[q].real / size
+        for q in range(1, count)]
+
+
+def compute(kind, signal, rate):
+    '''
+    returns (frames, name of the implementation used)
+    '''
+    if kind == 'mfcc':
+        try:
+            import numpy
+            from features import mfcc
+            return mfcc(numpy.array(signal), rate).tolist(), 'features.mfcc'
+        except ImportError:
+            return mfcc_port(signal, rate), 'pure python port of features.mfcc'
+    if kind == 'lpc':
+        try:
+            import numpy
+            from features import sigproc
+            from scikits.talkbox import lpc
+            frames = sigproc.framesig(numpy.array(signal), 0.025 * rate, 0.01 * rate)
+            return [lpc(frame, 12)[0].tolist() for frame in frames], 'scikits.talkbox lpc'
+        except ImportError:
+            return [a for a, e in lpc_frames(signal, rate)], \
+                'pure python port of talkbox lpc'
+    if kind == 'lpcc':
+        return [lpcc_numeric(a, e) for a, e in lpc_frames(signal, rate)], \
+            'numerical cepstrum of the ported talkbox lpc'
+    raise ValueError('unknown feature type: ' + kind)
+
+
+def main(argv):
+    kind = 'mfcc'
+    if len(argv) == 5:
+        kind = argv.pop(1)
+    if len(argv) != 4:
+        print(__doc__)
+        return 1
+
+    seconds = float(argv[1])
+    signal = generate_signal(int(seconds * SAMPLE_RATE), SAMPLE_RATE)
+    write_wave(argv[2], signal, SAMPLE_RATE)
+
+    start = time.time()
+    frames, name = compute(kind, signal, SAMPLE_RATE)
+    elapsed = time.time() - start
+
+    with open(argv[3], 'w') as out:
+        for frame in frames:
+            out.write(' '.join(repr(float(x)) for x in frame) + '\n')
+
+    print('%s (%s): %d frames, %.3f s, %.1f frames/s' % (kind, name,
+        len(frames), elapsed, len(frames) / elapsed if elapsed > 0 else 0.0))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
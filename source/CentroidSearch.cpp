@@ -0,0 +1,224 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "CentroidSearch.h"
+
+#include "Simd.h"
+
+#include <chrono>
+#include <limits>
+
+namespace {
+    /*! \brief Largest vector (in bytes) the fixed kernels are used for
+     *  when an AVX2 or AVX-512 distance kernel is active (39 floats, but
+     *  not 26 doubles).
+     */
+    const std::size_t MaxWideSimdFixedBytes = 160;
+
+    /*! \brief Measures the nearest-centroid search of the active level.
+     *
+     *  \param dimensions The dimension count.
+     */
+    void BenchmarkSearch(unsigned int dimensions)
+    {
+        const unsigned int sampleCount = 4096;
+        const unsigned int centroidCount = 64;
+        const unsigned int rounds = 20;
+
+        // Reproducible values in [-1, 1).
+        unsigned int noise = 12345;
+        auto generate = [&]() {
+            std::vector< DynamicVector<Real> > vectors;
+
+            for (unsigned int c = 0; c < sampleCount; c++) {
+                vectors.emplace_back(dimensions);
+
+                for (unsigned int d = 0; d < dimensions; d++) {
+                    noise = noise * 1103515245u + 12345u;
+                    vectors.back()[d] =
+                        static_cast<Real>((noise >> 16) % 2001) / 1000.0f - 1.0f;
+                }
+            }
+
+            return vectors;
+        };
+
+        auto samples = generate();
+        auto centroids = generate();
+
+        volatile unsigned int sink = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int r = 0; r < rounds; r++) {
+            CentroidSearch search(centroids, centroidCount);
+
+            for (const auto& sample : samples)
+                sink = sink + search.Find(sample);
+        }
+
+        std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+        double calls = static_cast<double>(rounds) * sampleCount * centroidCount;
+
+        std::cout << "  " << dimensions << ": " << elapsed.count() * 1e9 / calls;
+
+        start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int r = 0; r < rounds; r++) {
+            for (const auto& sample : samples) {
+                Real minDist = std::numeric_limits<Real>::max();
+                unsigned int minC = -1;
+
+                for (unsigned int c = 0; c < centroidCount; c++) {
+                    Real dist = sample.Distance(centroids[c]);
+
+                    if (dist < minDist) {
+                        minDist = dist;
+                        minC = c;
+                    }
+                }
+
+                sink = sink + minC;
+            }
+        }
+
+        elapsed = std::chrono::high_resolution_clock::now() - start;
+        std::cout << " " << elapsed.count() * 1e9 / calls << std::endl;
+    }
+}
+
+CentroidSearch::CentroidSearch(
+    const std::vector< DynamicVector<Real> >& centroids,
+    unsigned int count,
+    const std::vector<unsigned int>* sizes) :
+    mFind(&CentroidSearch::FindDynamic),
+    mDimensions(count > 0 ? centroids[0].GetSize() : 0),
+    mBlockCount((count + CentroidBlockWidth - 1) / CentroidBlockWidth),
+    mCentroids(&centroids)
+{
+    mIndices.reserve(count);
+
+    for (unsigned int c = 0; c < count; ++c) {
+        if (sizes == nullptr || (*sizes)[c] > 0)
+            mIndices.push_back(c);
+    }
+
+    // The fixed kernels compute with SSE2-width registers, the wide
+    // distance kernels catch up with longer vectors.
+    bool fixed = GetSimdLevel() < SimdLevel::AVX2
+        || mDimensions * sizeof(Real) <= MaxWideSimdFixedBytes;
+
+    if (!fixed)
+        return;
+
+    switch (mDimensions) {
+    case 13:
+        Pack<13>(centroids);
+        break;
+    case 26:
+        Pack<26>(centroids);
+        break;
+    case 39:
+        Pack<39>(centroids);
+        break;
+    default:
+        break;
+    }
+}
+
+unsigned int CentroidSearch::Find(const DynamicVector<Real>& sample) const
+{
+    return mFind(*this, sample.GetData());
+}
+
+template<unsigned int N>
+void CentroidSearch::Pack(const std::vector< DynamicVector<Real> >& centroids)
+{
+    // Skipped centroids and the padding of the last block are at the
+    // largest distance, they never become the nearest one.
+    mBlocks.assign(mBlockCount * N * CentroidBlockWidth,
+        std::numeric_limits<Real>::max());
+
+    auto blocks = reinterpret_cast<FixedCentroidBlock<N>*>(mBlocks.data());
+
+    for (unsigned int c : mIndices) {
+        auto& block = blocks[c / CentroidBlockWidth];
+
+        for (unsigned int d = 0; d < N; ++d)
+            block.values[d][c % CentroidBlockWidth] = centroids[c][d];
+    }
+
+    mFind = &CentroidSearch::FindFixed<N>;
+}
+
+template<unsigned int N>
+unsigned int CentroidSearch::FindFixed(const CentroidSearch& search, const Real* sample)
+{
+    auto blocks = reinterpret_cast<const FixedCentroidBlock<N>*>(search.mBlocks.data());
+
+    Real minDist = std::numeric_limits<Real>::max();
+    unsigned int minC = -1;
+
+    for (unsigned int b = 0; b < search.mBlockCount; ++b) {
+        const auto& block = blocks[b];
+
+        Real dists[CentroidBlockWidth] = {};
+
+        for (unsigned int d = 0; d < N; ++d) {
+            Real value = sample[d];
+
+            for (unsigned int w = 0; w < CentroidBlockWidth; ++w) {
+                Real diff = value - block.values[d][w];
+                dists[w] += diff * diff;
+            }
+        }
+
+        for (unsigned int w = 0; w < CentroidBlockWidth; ++w) {
+            if (dists[w] < minDist) {
+                minDist = dists[w];
+                minC = b * CentroidBlockWidth + w;
+            }
+        }
+    }
+
+    return minC;
+}
+
+unsigned int CentroidSearch::FindDynamic(const CentroidSearch& search, const Real* sample)
+{
+    const auto& centroids = *search.mCentroids;
+
+    Real minDist = std::numeric_limits<Real>::max();
+    unsigned int minC = -1;
+
+    for (unsigned int c : search.mIndices) {
+        Real dist = VectorDistance(sample, centroids[c].GetData(), search.mDimensions);
+
+        if (dist < minDist) {
+            minDist = dist;
+            minC = c;
+        }
+    }
+
+    return minC;
+}
+
+void BenchmarkCentroidSearch()
+{
+    SimdLevel original = GetSimdLevel();
+    const unsigned int dimensions[] = { 13, 26, 39 };
+
+    for (int level = 0; level <= static_cast<int>(DetectSimdLevel()); level++) {
+        SetSimdLevel(static_cast<SimdLevel>(level));
+
+        std::cout << GetSimdLevelName(GetSimdLevel())
+            << " (ns per distance: CentroidSearch, Distance() loop)" << std::endl;
+
+        for (unsigned int d : dimensions)
+            BenchmarkSearch(d);
+    }
+
+    SetSimdLevel(original);
+}
@@ -0,0 +1,99 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "Deltas.h"
+
+namespace
+{
+    /*! \brief Calculates the deltas of a single frame.
+     *
+     *  \see ComputeDeltas()
+     */
+    void ComputeDeltaRow(const Real* input, unsigned int stride,
+        unsigned int frame, unsigned int frameCount,
+        unsigned int dimensionCount, Real* output)
+    {
+        Real denominator = 0.0f;
+
+        for (unsigned int n = 1; n <= DeltaWindow; ++n)
+            denominator += static_cast<Real>(n * n);
+
+        for (unsigned int d = 0; d < dimensionCount; ++d)
+            output[d] = 0.0f;
+
+        for (unsigned int n = 1; n <= DeltaWindow; ++n) {
+            const Real* previous = input
+                + static_cast<std::size_t>(frame >= n ? frame - n : 0) * stride;
+            const Real* next = input
+                + static_cast<std::size_t>(Min(frame + n, frameCount - 1)) * stride;
+            Real weight = static_cast<Real>(n);
+
+            for (unsigned int d = 0; d < dimensionCount; ++d)
+                output[d] += weight * (next[d] - previous[d]);
+        }
+
+        Real scale = 0.5f / denominator;
+
+        for (unsigned int d = 0; d < dimensionCount; ++d)
+            output[d] *= scale;
+    }
+}
+
+void ComputeDeltas(const Real* input, unsigned int inputStride, Real* output,
+    unsigned int outputStride, unsigned int frameCount,
+    unsigned int dimensionCount)
+{
+    for (unsigned int t = 0; t < frameCount; ++t) {
+        ComputeDeltaRow(input, inputStride, t, frameCount, dimensionCount,
+            output + static_cast<std::size_t>(t) * outputStride);
+    }
+}
+
+void AddDeltas(const Real* frames, unsigned int frameCount,
+    unsigned int dimensionCount, unsigned int stride, unsigned int order,
+    FeatureMatrix& features)
+{
+    unsigned int columns = dimensionCount * (order + 1);
+
+    features.Clear(columns);
+
+    if (frameCount == 0)
+        return;
+
+    if (stride == 0)
+        stride = dimensionCount;
+
+    Real* output = features.AppendRows(frameCount);
+
+    // Order k of frame u needs order k - 1 up to frame u + DeltaWindow.
+    unsigned int steps = frameCount + (order > 0 ? (order - 1) * DeltaWindow : 0);
+
+    for (unsigned int t = 0; t < steps; ++t) {
+        if (t < frameCount) {
+            const Real* values = frames + static_cast<std::size_t>(t) * stride;
+            Real* row = output + static_cast<std::size_t>(t) * columns;
+
+            for (unsigned int d = 0; d < dimensionCount; ++d)
+                row[d] = values[d];
+
+            if (order > 0) {
+                ComputeDeltaRow(frames, stride, t, frameCount, dimensionCount,
+                    row + dimensionCount);
+            }
+        }
+
+        for (unsigned int k = 2; k <= order; ++k) {
+            unsigned int lag = (k - 1) * DeltaWindow;
+
+            if (t < lag || t - lag >= frameCount)
+                continue;
+
+            unsigned int u = t - lag;
+
+            ComputeDeltaRow(output + (k - 1) * dimensionCount, columns, u,
+                frameCount, dimensionCount,
+                output + static_cast<std::size_t>(u) * columns + k * dimensionCount);
+        }
+    }
+}
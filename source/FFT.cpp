@@ -0,0 +1,151 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "FFT.h"
+
+namespace
+{
+    const double Pi = 3.14159265358979323846;
+}
+
+FFT::FFT(unsigned int size)
+{
+    SetSize(size);
+}
+
+FFT::~FFT()
+{
+
+}
+
+void FFT::SetSize(unsigned int size)
+{
+    mSize = size;
+    mPowerOfTwo = size >= 2 && (size & (size - 1)) == 0;
+
+    mCos.resize(size);
+    mSin.resize(size);
+
+    for (unsigned int k = 0; k < size; ++k) {
+        double angle = 2.0 * Pi * k / size;
+        mCos[k] = static_cast<Real>(std::cos(angle));
+        mSin[k] = static_cast<Real>(std::sin(angle));
+    }
+
+    if (!mPowerOfTwo) {
+        mBitReverse.clear();
+        mReal.clear();
+        mImag.clear();
+        return;
+    }
+
+    unsigned int half = size / 2;
+    unsigned int bits = 0;
+
+    while ((1u << bits) < half)
+        ++bits;
+
+    mBitReverse.resize(half);
+
+    for (unsigned int n = 0; n < half; ++n) {
+        unsigned int reversed = 0;
+
+        for (unsigned int b = 0; b < bits; ++b)
+            reversed |= ((n >> b) & 1) << (bits - 1 - b);
+
+        mBitReverse[n] = reversed;
+    }
+
+    mReal.resize(half);
+    mImag.resize(half);
+}
+
+unsigned int FFT::GetSize() const
+{
+    return mSize;
+}
+
+void FFT::GetPowerSpectrum(const Real* input, Real* power)
+{
+    unsigned int half = mSize / 2;
+
+    if (!mPowerOfTwo) {
+        // Direct DFT.
+        for (unsigned int k = 0; k <= half; ++k) {
+            Real re = 0.0f;
+            Real im = 0.0f;
+            unsigned int index = 0;
+
+            for (unsigned int n = 0; n < mSize; ++n) {
+                re += input[n] * mCos[index];
+                im -= input[n] * mSin[index];
+
+                index += k;
+
+                if (index >= mSize)
+                    index -= mSize;
+            }
+
+            power[k] = re * re + im * im;
+        }
+
+        return;
+    }
+
+    // Even samples as the real part, odd samples as the imaginary part.
+    for (unsigned int n = 0; n < half; ++n) {
+        mReal[mBitReverse[n]] = input[2 * n];
+        mImag[mBitReverse[n]] = input[2 * n + 1];
+    }
+
+    Transform();
+
+    // Split the half size transform to the spectrum of the real signal.
+    power[0] = (mReal[0] + mImag[0]) * (mReal[0] + mImag[0]);
+    power[half] = (mReal[0] - mImag[0]) * (mReal[0] - mImag[0]);
+
+    for (unsigned int k = 1; k < half; ++k) {
+        Real ar = mReal[k];
+        Real ai = mImag[k];
+        Real br = mReal[half - k];
+        Real bi = mImag[half - k];
+
+        Real evenReal = 0.5f * (ar + br);
+        Real evenImag = 0.5f * (ai - bi);
+        Real oddReal = 0.5f * (ai + bi);
+        Real oddImag = -0.5f * (ar - br);
+
+        Real re = evenReal + mCos[k] * oddReal + mSin[k] * oddImag;
+        Real im = evenImag + mCos[k] * oddImag - mSin[k] * oddReal;
+
+        power[k] = re * re + im * im;
+    }
+}
+
+void FFT::Transform()
+{
+    unsigned int half = mSize / 2;
+    Real* real = mReal.data();
+    Real* imag = mImag.data();
+
+    for (unsigned int length = 2; length <= half; length *= 2) {
+        unsigned int middle = length / 2;
+        unsigned int step = mSize / length;
+
+        for (unsigned int j = 0; j < middle; ++j) {
+            Real c = mCos[j * step];
+            Real s = mSin[j * step];
+
+            for (unsigned int i = j; i < half; i += length) {
+                Real vr = real[i + middle] * c + imag[i + middle] * s;
+                Real vi = imag[i + middle] * c - real[i + middle] * s;
+
+                real[i + middle] = real[i] - vr;
+                imag[i + middle] = imag[i] - vi;
+                real[i] += vr;
+                imag[i] += vi;
+            }
+        }
+    }
+}
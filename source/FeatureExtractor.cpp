@@ -0,0 +1,526 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "FeatureExtractor.h"
+
+#include "Deltas.h"
+#include "FeatureFile.h"
+#include "FeatureParser.h"
+#include "LineIndex.h"
+#include "LPC.h"
+#include "MFCC.h"
+#include "Parallel.h"
+#include "SpeakerManifest.h"
+#include "Timer.h"
+#include "VoiceActivityDetector.h"
+#include "WaveFile.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    /*! \brief Lists the entries of a folder.
+     *
+     *  \param folder The folder.
+     *  \param folders True for subfolders, false for files.
+     *
+     *  \return The entry names (unsorted).
+     */
+    std::vector<std::string> ListFolder(const std::string& folder, bool folders)
+    {
+        std::vector<std::string> names;
+
+#ifdef _WIN32
+        WIN32_FIND_DATAA data;
+        HANDLE handle = FindFirstFileA((folder + "\\*").c_str(), &data);
+
+        if (handle == INVALID_HANDLE_VALUE)
+            return names;
+
+        do {
+            std::string name = data.cFileName;
+            bool isFolder = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+
+            if (name != "." && name != ".." && isFolder == folders)
+                names.push_back(name);
+        } while (FindNextFileA(handle, &data));
+
+        FindClose(handle);
+#else
+        DIR* dir = opendir(folder.c_str());
+
+        if (dir == nullptr)
+            return names;
+
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            struct stat st;
+
+            if (name == "." || name == ".."
+                || stat((folder + "/" + name).c_str(), &st) != 0)
+                continue;
+
+            if (S_ISDIR(st.st_mode) == folders)
+                names.push_back(name);
+        }
+
+        closedir(dir);
+#endif
+
+        return names;
+    }
+
+    /*! \brief Returns the number in a name (e.g. 225 of p225, 1 of p225_001).
+     *
+     *  \param name The name.
+     *  \param number Output, the digits after the last underscore (or the
+     *  first digits if there is no underscore).
+     *
+     *  \return True if the name has a number, false otherwise.
+     */
+    bool GetNameNumber(const std::string& name, unsigned int& number)
+    {
+        std::size_t position = name.rfind('_');
+
+        position = (position == std::string::npos)
+            ? name.find_first_of("0123456789") : position + 1;
+
+        if (position >= name.size() || !isdigit(name[position]))
+            return false;
+
+        number = static_cast<unsigned int>(std::strtoul(name.c_str() + position,
+            nullptr, 10));
+
+        return true;
+    }
+
+    /*! \brief Sorts names by their numbers, names without numbers last.
+     */
+    void SortNames(std::vector<std::string>& names)
+    {
+        std::sort(names.begin(), names.end(),
+            [](const std::string& a, const std::string& b) {
+            unsigned int na = 0;
+            unsigned int nb = 0;
+            bool ha = GetNameNumber(a, na);
+            bool hb = GetNameNumber(b, nb);
+
+            if (ha != hb) return ha;
+            if (na != nb) return na < nb;
+
+            return a < b;
+        });
+    }
+
+    bool HasExtension(const std::string& name, const std::string& extension)
+    {
+        return name.size() > extension.size()
+            && name.compare(name.size() - extension.size(), extension.size(),
+                extension) == 0;
+    }
+
+    /*! \brief Generates a test signal: two tones and uniform noise in the
+     *  16-bit range.
+     */
+    std::vector<Real> GenerateSignal(unsigned int length, unsigned int sampleRate)
+    {
+        const double Pi = 3.14159265358979323846;
+        std::vector<Real> signal(length);
+        uint32_t noise = 12345;
+
+        for (unsigned int i = 0; i < length; ++i) {
+            double t = static_cast<double>(i) / sampleRate;
+
+            noise = noise * 1103515245u + 12345u;
+
+            signal[i] = static_cast<Real>(std::floor(
+                5000.0 * std::sin(2.0 * Pi * 300.0 * t)
+                + 2000.0 * std::sin(2.0 * Pi * 2100.0 * t)
+                + static_cast<double>((noise >> 16) % 1001) - 500.0));
+        }
+
+        return signal;
+    }
+
+    /*! \brief Times a front-end on a signal and prints the throughput.
+     */
+    template<typename T>
+    void BenchmarkFrontEnd(const std::string& name, T& frontEnd,
+        const std::vector<Real>& signal, unsigned int sampleRate)
+    {
+        unsigned int length = static_cast<unsigned int>(signal.size());
+        Real seconds = static_cast<Real>(length) / sampleRate;
+        FeatureMatrix features;
+
+        // The first call prepares the tables.
+        frontEnd.Compute(signal.data(), length, sampleRate, features);
+
+        Timer timer;
+        frontEnd.Compute(signal.data(), length, sampleRate, features);
+        Real time = timer.GetTimeElapsed();
+
+        std::cout << name << " (" << sampleRate << " Hz, " << seconds << " s): "
+            << features.GetRowCount() << " frames, " << time << " s, "
+            << (time > 0.0f ? features.GetRowCount() / time : 0.0f)
+            << " frames/s, " << (time > 0.0f ? seconds / time : 0.0f)
+            << "x real time" << std::endl;
+    }
+
+    /*! \brief Removes the files derived from a text sample file (binary
+     *  features and line index).
+     */
+    void RemoveSampleCaches(const std::string& path)
+    {
+        std::remove(GetBinarySamplesPath(path).c_str());
+        std::remove(GetLineIndexPath(path).c_str());
+    }
+}
+
+FeatureExtractor::FeatureExtractor()
+    : mFeatureType(FeatureType::MFCC),
+    mDeltaOrder(2),
+    mRemoveSilence(false),
+    mThreadCount(0)
+{
+
+}
+
+FeatureExtractor::~FeatureExtractor()
+{
+
+}
+
+void FeatureExtractor::SetFeatureType(FeatureType featureType)
+{
+    mFeatureType = featureType;
+}
+
+void FeatureExtractor::SetDeltaOrder(unsigned int deltaOrder)
+{
+    mDeltaOrder = Min(deltaOrder, 2u);
+}
+
+void FeatureExtractor::SetRemoveSilence(bool removeSilence)
+{
+    mRemoveSilence = removeSilence;
+}
+
+void FeatureExtractor::SetThreadCount(unsigned int threadCount)
+{
+    mThreadCount = threadCount;
+}
+
+bool FeatureExtractor::ExtractFile(const std::string& path,
+    const std::string& label, std::string& line, unsigned int& frameCount,
+    Real& duration) const
+{
+    WaveFile file;
+
+    if (!file.Open(path))
+        return false;
+
+    duration = static_cast<Real>(file.GetLength()) / file.GetSampleRate();
+
+    MFCC mfcc;
+    LPC::Parameters parameters;
+
+    if (mFeatureType == FeatureType::LPC)
+        parameters.cepstrumCount = 0;
+
+    LPC lpc(parameters);
+    FeatureMatrix coefficients;
+
+    if (mRemoveSilence) {
+        // Stream the recording through the detector a chunk at a time.
+        VoiceActivityDetector detector(file.GetSampleRate());
+        std::vector<Real> chunk(file.GetSampleRate());
+        std::vector<Real> signal;
+
+        for (unsigned int first = 0; first < file.GetLength();
+            first += static_cast<unsigned int>(chunk.size())) {
+            unsigned int count = file.Read(first,
+                static_cast<unsigned int>(chunk.size()), chunk.data());
+
+            detector.Process(chunk.data(), count, signal);
+        }
+
+        detector.Flush(signal);
+
+        if (mFeatureType == FeatureType::MFCC) {
+            mfcc.Compute(signal.data(), static_cast<unsigned int>(signal.size()),
+                file.GetSampleRate(), coefficients);
+        } else {
+            lpc.Compute(signal.data(), static_cast<unsigned int>(signal.size()),
+                file.GetSampleRate(), coefficients);
+        }
+    } else if (mFeatureType == FeatureType::MFCC) {
+        mfcc.Compute(file, coefficients);
+    } else {
+        lpc.Compute(file, coefficients);
+    }
+
+    FeatureMatrix features;
+
+    AddDeltas(coefficients.GetRow(0), coefficients.GetRowCount(),
+        coefficients.GetColumnCount(), 0, mDeltaOrder, features);
+
+    std::ostringstream ss;
+    WriteTextSamples(ss, label, features);
+
+    line = ss.str();
+    frameCount = features.GetRowCount();
+
+    return true;
+}
+
+bool FeatureExtractor::ExtractCorpus(const std::string& corpusFolder,
+    const std::string& outputFolder) const
+{
+    std::vector<std::string> speakers = ListFolder(corpusFolder, true);
+
+    SortNames(speakers);
+
+    if (speakers.empty()) {
+        std::cout << "No speaker folders in '" << corpusFolder << "'."
+            << std::endl;
+        return false;
+    }
+
+    unsigned int threads = (mThreadCount > 0) ? mThreadCount : GetThreadCount();
+
+    std::cout << "Extracting " << speakers.size() << " speakers from '"
+        << corpusFolder << "' to '" << outputFolder << "' (" << threads
+        << " threads)." << std::endl;
+
+    Timer timer;
+    unsigned int speakerNumber = 0;
+    unsigned int totalFiles = 0;
+    unsigned int failedFiles = 0;
+    double totalDuration = 0.0;
+
+    for (const auto& speaker : speakers) {
+        std::string speakerFolder = corpusFolder + "/" + speaker;
+        std::vector<std::string> files;
+
+        for (const auto& name : ListFolder(speakerFolder, false)) {
+            if (HasExtension(name, ".wav"))
+                files.push_back(name);
+        }
+
+        if (files.empty())
+            continue;
+
+        SortNames(files);
+
+        // Speaker id without the prefix (p225 -> 225).
+        unsigned int speakerId = 0;
+        std::string id = GetNameNumber(speaker, speakerId)
+            ? toString(speakerId) : speaker;
+
+        unsigned int count = static_cast<unsigned int>(files.size());
+        std::vector<std::string> lines(count);
+        std::vector<unsigned int> frameCounts(count, 0);
+        std::vector<Real> durations(count, 0.0f);
+        std::vector<char> extracted(count, 0);
+
+        ParallelFor(count, [&](unsigned int i) {
+            unsigned int utterance = 0;
+            std::string label = id + "_" + (GetNameNumber(files[i], utterance)
+                ? toString(utterance) : files[i].substr(0, files[i].size() - 4));
+
+            extracted[i] = ExtractFile(speakerFolder + "/" + files[i], label,
+                lines[i], frameCounts[i], durations[i]);
+        }, threads);
+
+        std::string samples;
+        unsigned int frames = 0;
+        double duration = 0.0;
+        unsigned int extractedFiles = 0;
+
+        for (unsigned int i = 0; i < count; ++i) {
+            if (extracted[i]) {
+                samples += lines[i];
+                frames += frameCounts[i];
+                duration += durations[i];
+                ++extractedFiles;
+            } else {
+                ++failedFiles;
+            }
+        }
+
+        // An empty sample file would be skipped by the speaker manifest and
+        // shift the numbers of the following speakers.
+        if (extractedFiles == 0) {
+            std::cout << "Speaker " << speaker << ": no files extracted, "
+                << "skipped." << std::endl;
+            continue;
+        }
+
+        // A single sequential write per speaker.
+        ++speakerNumber;
+
+        std::string path = outputFolder + "/samples_" + toString(speakerNumber)
+            + ".txt";
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(samples.data(), samples.size());
+
+        if (!file.good()) {
+            std::cout << "Could not write '" << path << "'." << std::endl;
+            return false;
+        }
+
+        // A binary file converted from the previous samples would be
+        // preferred over the new text file.
+        RemoveSampleCaches(path);
+
+        totalFiles += count;
+        totalDuration += duration;
+
+        Real time = timer.GetTimeElapsed();
+
+        std::cout << "Speaker " << speakerNumber << "/" << speakers.size()
+            << " (" << speaker << " -> samples_" << speakerNumber << ".txt): "
+            << count << " files, " << frames << " frames, " << duration
+            << " s audio | total " << totalFiles << " files, " << time
+            << " s, " << (time > 0.0f ? totalFiles / time : 0.0f)
+            << " files/s, " << (time > 0.0f ? totalDuration / time : 0.0)
+            << "x real time" << std::endl;
+    }
+
+    // Remove sample files left from a larger earlier extraction, probed
+    // the same way as in SpeakerManifest::Build().
+    for (unsigned int n = speakerNumber + 1; ; ++n) {
+        std::string path = outputFolder + "/samples_" + toString(n) + ".txt";
+
+        if (FileExists(path))
+            std::remove(path.c_str());
+        else if (n >= 109)
+            break;
+
+        RemoveSampleCaches(path);
+    }
+
+    // The speaker manifest of the previous samples is no longer valid.
+    SpeakerManifest manifest;
+
+    if (!manifest.Build(outputFolder)
+        || !manifest.Save(GetSpeakerManifestPath(outputFolder))) {
+        std::cout << "Could not build speaker manifest: " << outputFolder
+            << std::endl;
+    }
+
+    if (failedFiles > 0) {
+        std::cout << "Extraction failed for " << failedFiles << " files."
+            << std::endl;
+    }
+
+    return failedFiles == 0;
+}
+
+void BenchmarkFeatureExtraction(Real seconds)
+{
+    const unsigned int sampleRate = 16000;
+    std::vector<Real> signal = GenerateSignal(
+        static_cast<unsigned int>(seconds * sampleRate), sampleRate);
+
+    MFCC mfcc;
+    BenchmarkFrontEnd("MFCC", mfcc, signal, sampleRate);
+
+    LPC::Parameters parameters;
+    parameters.cepstrumCount = 0;
+
+    LPC lpc(parameters);
+    BenchmarkFrontEnd("LPC", lpc, signal, sampleRate);
+
+    LPC lpcc;
+    BenchmarkFrontEnd("LPCC", lpcc, signal, sampleRate);
+}
+
+bool CompareFeatures(const std::string& wavePath,
+    const std::string& referencePath,
+    FeatureExtractor::FeatureType featureType, Real tolerance)
+{
+    FeatureExtractor extractor;
+    extractor.SetFeatureType(featureType);
+    extractor.SetDeltaOrder(0);
+    extractor.SetThreadCount(1);
+
+    std::string line;
+    unsigned int frameCount;
+    Real duration;
+
+    if (!extractor.ExtractFile(wavePath, "0", line, frameCount, duration))
+        return false;
+
+    FeatureParser parser;
+
+    if (!parser.Parse(line)) {
+        std::cout << "No features in '" << wavePath << "'." << std::endl;
+        return false;
+    }
+
+    std::ifstream reference(referencePath);
+
+    if (!reference.good()) {
+        std::cout << "Could not open '" << referencePath << "'." << std::endl;
+        return false;
+    }
+
+    double maxDifference = 0.0;
+    double maxRelativeDifference = 0.0;
+    unsigned int frame = 0;
+
+    while (std::getline(reference, line)) {
+        std::stringstream ss(line);
+        std::vector<double> values;
+        double value;
+
+        while (ss >> value)
+            values.push_back(value);
+
+        if (values.empty())
+            continue;
+
+        if (frame >= parser.GetFrameCount()
+            || values.size() != parser.GetFrameSize(frame)) {
+            std::cout << "Frame " << frame << " does not match the reference."
+                << std::endl;
+            return false;
+        }
+
+        const float* features = parser.GetFrame(frame);
+
+        for (unsigned int d = 0; d < values.size(); ++d) {
+            double difference = std::fabs(features[d] - values[d]);
+
+            maxDifference = Max(maxDifference, difference);
+            maxRelativeDifference = Max(maxRelativeDifference,
+                difference / Max(std::fabs(values[d]), 1.0));
+        }
+
+        ++frame;
+    }
+
+    if (frame != parser.GetFrameCount()) {
+        std::cout << "Frame count mismatch: " << parser.GetFrameCount()
+            << " (reference " << frame << ")." << std::endl;
+        return false;
+    }
+
+    std::cout << frame << " frames, max difference " << maxDifference
+        << ", max relative difference " << maxRelativeDifference << std::endl;
+
+    return maxRelativeDifference <= tolerance;
+}
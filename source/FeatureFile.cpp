@@ -0,0 +1,315 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "FeatureFile.h"
+#include "FeatureParser.h"
+
+#include <cstring>
+
+namespace
+{
+    const uint64_t PayloadAlignment = 64;
+
+    uint64_t Align(uint64_t offset, uint64_t alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    void WritePadding(std::ofstream& file, uint64_t from, uint64_t to)
+    {
+        for (uint64_t i = from; i < to; ++i)
+            file.put(0);
+    }
+}
+
+bool ConvertTextSamples(const std::string& textPath,
+    const std::string& binaryPath)
+{
+    std::ifstream file(textPath);
+
+    FeatureFile::Header header;
+
+    if (!file.good()
+        || !GetFileStatus(textPath, header.sourceSize, header.sourceTime)) {
+        std::cout << "Could not open '" << textPath << "'." << std::endl;
+        return false;
+    }
+
+    std::vector<uint64_t> frameOffsets(1, 0);
+    std::vector<uint32_t> labelOffsets(1, 0);
+    std::string labels;
+    std::vector<float> payload;
+
+    unsigned int dimensionCount = 0;
+    std::string line;
+
+    FeatureParser parser;
+
+    while (std::getline(file, line)) {
+        // Lines without a label are kept as empty utterances so that
+        // line numbering is preserved.
+        std::string label;
+
+        if (parser.Parse(line)) {
+            label = parser.GetLabel();
+
+            for (unsigned int n = 0; n < parser.GetFrameCount(); ++n) {
+                if (dimensionCount == 0)
+                    dimensionCount = parser.GetFrameSize(n);
+
+                if (parser.GetFrameSize(n) != dimensionCount) {
+                    std::cout << "Could not convert '" << textPath
+                        << "': feature count mismatch." << std::endl;
+                    return false;
+                }
+
+                payload.insert(payload.end(), parser.GetFrame(n),
+                    parser.GetFrame(n) + dimensionCount);
+            }
+        }
+
+        labels += label;
+
+        labelOffsets.push_back(static_cast<uint32_t>(labels.size()));
+        frameOffsets.push_back(dimensionCount > 0
+            ? payload.size() / dimensionCount : 0);
+    }
+
+    std::memcpy(header.magic, "SOPF", 4);
+    header.version = FeatureFile::Version;
+    header.dimensionCount = dimensionCount;
+    header.utteranceCount = static_cast<uint32_t>(frameOffsets.size() - 1);
+    header.frameCount = frameOffsets.back();
+    header.frameOffsetsOffset = sizeof(FeatureFile::Header);
+    header.labelOffsetsOffset = header.frameOffsetsOffset
+        + frameOffsets.size() * sizeof(uint64_t);
+    header.labelsOffset = header.labelOffsetsOffset
+        + labelOffsets.size() * sizeof(uint32_t);
+    header.payloadOffset = Align(header.labelsOffset + labels.size(),
+        PayloadAlignment);
+
+    std::ofstream out(binaryPath, std::ios::binary | std::ios::trunc);
+
+    if (!out.good()) {
+        std::cout << "Could not create '" << binaryPath << "'." << std::endl;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(frameOffsets.data()),
+        frameOffsets.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(labelOffsets.data()),
+        labelOffsets.size() * sizeof(uint32_t));
+    out.write(labels.data(), labels.size());
+    WritePadding(out, header.labelsOffset + labels.size(), header.payloadOffset);
+    out.write(reinterpret_cast<const char*>(payload.data()),
+        payload.size() * sizeof(float));
+
+    if (!out.good()) {
+        std::cout << "Could not write '" << binaryPath << "'." << std::endl;
+        return false;
+    }
+
+    std::cout << "Converted '" << textPath << "' to '" << binaryPath << "' ("
+        << header.utteranceCount << " utterances, " << header.frameCount
+        << " frames, " << dimensionCount << " dimensions)." << std::endl;
+
+    return true;
+}
+
+bool AppendTextSamples(const std::string& path, const std::string& label,
+    const FeatureMatrix& frames)
+{
+    std::ofstream file(path, std::ios::app);
+
+    if (!file.good()) {
+        std::cout << "Could not open '" << path << "'." << std::endl;
+        return false;
+    }
+
+    WriteTextSamples(file, label, frames);
+
+    return file.good();
+}
+
+void WriteTextSamples(std::ostream& stream, const std::string& label,
+    const FeatureMatrix& frames)
+{
+    // Enough digits to restore float features exactly.
+    std::streamsize precision = stream.precision(9);
+
+    stream << label << " ";
+
+    for (unsigned int n = 0; n < frames.GetRowCount(); ++n) {
+        const Real* frame = frames.GetRow(n);
+
+        if (n > 0)
+            stream << ",";
+
+        for (unsigned int d = 0; d < frames.GetColumnCount(); ++d) {
+            if (d > 0)
+                stream << " ";
+
+            stream << frame[d];
+        }
+    }
+
+    stream << "\n";
+
+    stream.precision(precision);
+}
+
+std::string GetBinarySamplesPath(const std::string& textPath)
+{
+    std::string path = textPath;
+    std::size_t dot = path.find_last_of('.');
+    std::size_t slash = path.find_last_of("/\\");
+
+    if (dot != std::string::npos
+        && (slash == std::string::npos || dot > slash)) {
+        path.erase(dot);
+    }
+
+    return path + ".bin";
+}
+
+FeatureFile::FeatureFile()
+    : mHeader(nullptr),
+    mFrameOffsets(nullptr),
+    mLabelOffsets(nullptr),
+    mLabels(nullptr),
+    mPayload(nullptr)
+{
+
+}
+
+FeatureFile::~FeatureFile()
+{
+
+}
+
+bool FeatureFile::Open(const std::string& path, const std::string& sourcePath)
+{
+    Close();
+
+    if (!mFile.Open(path))
+        return false;
+
+    const char* data = mFile.GetData();
+    uint64_t size = mFile.GetSize();
+
+    if (size < sizeof(Header)) {
+        Close();
+        return false;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(data);
+
+    if (std::memcmp(header->magic, "SOPF", 4) != 0
+        || header->version != Version) {
+        std::cout << "Invalid feature file '" << path << "'." << std::endl;
+        Close();
+        return false;
+    }
+
+    if (!sourcePath.empty()) {
+        uint64_t sourceSize;
+        int64_t sourceTime;
+
+        if (!GetFileStatus(sourcePath, sourceSize, sourceTime)
+            || header->sourceSize != sourceSize
+            || header->sourceTime != sourceTime) {
+            std::cout << "Feature file '" << path << "' is out of date." << std::endl;
+            Close();
+            return false;
+        }
+    }
+
+    uint64_t utterances = header->utteranceCount;
+
+    bool valid =
+        header->frameOffsetsOffset + (utterances + 1) * sizeof(uint64_t) <= size
+        && header->labelOffsetsOffset + (utterances + 1) * sizeof(uint32_t) <= size
+        && header->labelsOffset <= size
+        && header->payloadOffset % sizeof(float) == 0
+        && header->payloadOffset + header->frameCount
+            * header->dimensionCount * sizeof(float) <= size;
+
+    if (valid) {
+        mFrameOffsets = reinterpret_cast<const uint64_t*>(
+            data + header->frameOffsetsOffset);
+        mLabelOffsets = reinterpret_cast<const uint32_t*>(
+            data + header->labelOffsetsOffset);
+
+        valid = mFrameOffsets[0] == 0 && mLabelOffsets[0] == 0
+            && mFrameOffsets[utterances] == header->frameCount
+            && header->labelsOffset + mLabelOffsets[utterances] <= size;
+
+        // Offsets must not decrease, otherwise frame counts and labels
+        // would underflow.
+        for (uint64_t u = 0; valid && u < utterances; ++u) {
+            valid = mFrameOffsets[u] <= mFrameOffsets[u + 1]
+                && mLabelOffsets[u] <= mLabelOffsets[u + 1];
+        }
+    }
+
+    if (!valid) {
+        std::cout << "Corrupted feature file '" << path << "'." << std::endl;
+        Close();
+        return false;
+    }
+
+    mHeader = header;
+    mLabels = data + header->labelsOffset;
+    mPayload = reinterpret_cast<const float*>(data + header->payloadOffset);
+
+    return true;
+}
+
+void FeatureFile::Close()
+{
+    mFile.Close();
+    mHeader = nullptr;
+    mFrameOffsets = nullptr;
+    mLabelOffsets = nullptr;
+    mLabels = nullptr;
+    mPayload = nullptr;
+}
+
+bool FeatureFile::IsOpen() const
+{
+    return mHeader != nullptr;
+}
+
+unsigned int FeatureFile::GetDimensionCount() const
+{
+    return mHeader->dimensionCount;
+}
+
+unsigned int FeatureFile::GetUtteranceCount() const
+{
+    return mHeader->utteranceCount;
+}
+
+uint64_t FeatureFile::GetFrameCount() const
+{
+    return mHeader->frameCount;
+}
+
+std::string FeatureFile::GetLabel(unsigned int utterance) const
+{
+    return std::string(mLabels + mLabelOffsets[utterance],
+        mLabels + mLabelOffsets[utterance + 1]);
+}
+
+unsigned int FeatureFile::GetFrameCount(unsigned int utterance) const
+{
+    return static_cast<unsigned int>(
+        mFrameOffsets[utterance + 1] - mFrameOffsets[utterance]);
+}
+
+const float* FeatureFile::GetFrames(unsigned int utterance) const
+{
+    return mPayload + mFrameOffsets[utterance] * mHeader->dimensionCount;
+}
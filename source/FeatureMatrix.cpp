@@ -0,0 +1,73 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "FeatureMatrix.h"
+
+FeatureMatrix::FeatureMatrix(unsigned int columns)
+    : mColumns(columns),
+    mRows(0)
+{
+
+}
+
+FeatureMatrix::~FeatureMatrix()
+{
+
+}
+
+void FeatureMatrix::Clear(unsigned int columns)
+{
+    mValues.clear();
+    mColumns = columns;
+    mRows = 0;
+}
+
+void FeatureMatrix::Reserve(unsigned int rows)
+{
+    mValues.reserve(static_cast<std::size_t>(rows) * mColumns);
+}
+
+Real* FeatureMatrix::AppendRows(unsigned int rows)
+{
+    std::size_t offset = mValues.size();
+
+    mValues.resize(offset + static_cast<std::size_t>(rows) * mColumns);
+    mRows += rows;
+
+    return mValues.data() + offset;
+}
+
+void FeatureMatrix::Truncate(unsigned int rows)
+{
+    if (rows < mRows) {
+        mValues.resize(static_cast<std::size_t>(rows) * mColumns);
+        mRows = rows;
+    }
+}
+
+unsigned int FeatureMatrix::GetRowCount() const
+{
+    return mRows;
+}
+
+unsigned int FeatureMatrix::GetColumnCount() const
+{
+    return mColumns;
+}
+
+Real* FeatureMatrix::GetRow(unsigned int row)
+{
+    return mValues.data() + static_cast<std::size_t>(row) * mColumns;
+}
+
+const Real* FeatureMatrix::GetRow(unsigned int row) const
+{
+    return mValues.data() + static_cast<std::size_t>(row) * mColumns;
+}
+
+DynamicVector<Real> FeatureMatrix::GetRowView(unsigned int row,
+    unsigned int columns)
+{
+    return DynamicVector<Real>(GetRow(row), columns > 0 ? columns : mColumns);
+}
@@ -0,0 +1,189 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "FeatureParser.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    const float PowersOfTen[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+    };
+
+    /*! \brief Parses a float value.
+     *
+     *  Plain decimal values whose digits fit exactly in a float are
+     *  converted directly (a single correctly rounded division, so the
+     *  result equals std::strtof()), everything else is left to
+     *  std::strtof().
+     *
+     *  \param begin Beginning of the token.
+     *  \param end End of the token.
+     *  \param value The parsed value.
+     *
+     *  \return True if the token begins with a number, false otherwise.
+     */
+    bool ParseFloat(const char* begin, const char* end, float& value)
+    {
+        const char* it = begin;
+        bool negative = false;
+
+        if (it != end && (*it == '-' || *it == '+')) {
+            negative = (*it == '-');
+            ++it;
+        }
+
+        uint64_t mantissa = 0;
+        unsigned int digits = 0;
+        unsigned int decimals = 0;
+        bool point = false;
+
+        for (; it != end; ++it) {
+            if (*it >= '0' && *it <= '9') {
+                if (digits < 19)
+                    mantissa = mantissa * 10 + (*it - '0');
+
+                ++digits;
+
+                if (point)
+                    ++decimals;
+            } else if (*it == '.' && !point) {
+                point = true;
+            } else {
+                break;
+            }
+        }
+
+        if (it == end && digits > 0 && digits < 19
+            && mantissa <= (1u << 24) && decimals <= 10) {
+            value = static_cast<float>(mantissa) / PowersOfTen[decimals];
+
+            if (negative)
+                value = -value;
+
+            return true;
+        }
+
+        char* valueEnd = nullptr;
+        value = std::strtof(begin, &valueEnd);
+
+        return valueEnd != begin && valueEnd <= end;
+    }
+}
+
+FeatureParser::FeatureParser()
+    : mFrameOffsets(1, 0),
+    mUniform(true)
+{
+
+}
+
+FeatureParser::~FeatureParser()
+{
+
+}
+
+bool FeatureParser::Parse(const std::string& line, unsigned int maxFeatures)
+{
+    mLabel.clear();
+    mValues.clear();
+    mFrameOffsets.resize(1);
+    mUniform = true;
+
+    const char* it = line.c_str();
+    const char* end = it + line.size();
+
+    // Label, the first whitespace separated token.
+    while (it != end && std::isspace(static_cast<unsigned char>(*it)))
+        ++it;
+
+    const char* labelEnd = it;
+
+    while (labelEnd != end && !std::isspace(static_cast<unsigned char>(*labelEnd)))
+        ++labelEnd;
+
+    if (it == labelEnd)
+        return false;
+
+    mLabel.assign(it, labelEnd);
+    it = labelEnd;
+
+    // Feature vectors separated by commas.
+    while (it != end) {
+        const char* vectorEnd = static_cast<const char*>(
+            std::memchr(it, ',', end - it));
+
+        if (vectorEnd == nullptr)
+            vectorEnd = end;
+
+        unsigned int featureCount = 0;
+
+        // Features separated by spaces.
+        while (it != vectorEnd && featureCount < maxFeatures) {
+            if (*it == ' ') {
+                ++it;
+                continue;
+            }
+
+            const char* tokenEnd = static_cast<const char*>(
+                std::memchr(it, ' ', vectorEnd - it));
+
+            if (tokenEnd == nullptr)
+                tokenEnd = vectorEnd;
+
+            float value;
+
+            // Skip tokens that are not numbers.
+            if (ParseFloat(it, tokenEnd, value)) {
+                mValues.push_back(value);
+                ++featureCount;
+            }
+
+            it = tokenEnd;
+        }
+
+        if (featureCount > 0) {
+            if (mFrameOffsets.size() > 1
+                && featureCount != GetFrameSize(0)) {
+                mUniform = false;
+            }
+
+            mFrameOffsets.push_back(static_cast<unsigned int>(mValues.size()));
+        }
+
+        // Skip the separator (and discarded features).
+        it = (vectorEnd == end) ? end : vectorEnd + 1;
+    }
+
+    return true;
+}
+
+const std::string& FeatureParser::GetLabel() const
+{
+    return mLabel;
+}
+
+unsigned int FeatureParser::GetFrameCount() const
+{
+    return static_cast<unsigned int>(mFrameOffsets.size() - 1);
+}
+
+unsigned int FeatureParser::GetFrameSize(unsigned int frame) const
+{
+    return mFrameOffsets[frame + 1] - mFrameOffsets[frame];
+}
+
+const float* FeatureParser::GetFrame(unsigned int frame) const
+{
+    return mValues.data() + mFrameOffsets[frame];
+}
+
+bool FeatureParser::IsUniform() const
+{
+    return mUniform;
+}
@@ -0,0 +1,85 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "FeatureStatistics.h"
+
+FeatureStatistics::FeatureStatistics(unsigned int dimensionCount)
+    : mMeans(dimensionCount, 0.0f),
+    mSquares(dimensionCount, 0.0f),
+    mCount(0)
+{
+
+}
+
+FeatureStatistics::~FeatureStatistics()
+{
+
+}
+
+void FeatureStatistics::Clear(unsigned int dimensionCount)
+{
+    mMeans.assign(dimensionCount, 0.0f);
+    mSquares.assign(dimensionCount, 0.0f);
+    mCount = 0;
+}
+
+void FeatureStatistics::Add(const Real* frame)
+{
+    ++mCount;
+
+    Accumulator invCount = 1.0f / static_cast<Accumulator>(mCount);
+    Accumulator* means = mMeans.data();
+    Accumulator* squares = mSquares.data();
+    unsigned int dimensionCount = GetDimensionCount();
+
+    for (unsigned int d = 0; d < dimensionCount; ++d) {
+        Accumulator delta = frame[d] - means[d];
+        means[d] += delta * invCount;
+        squares[d] += delta * (frame[d] - means[d]);
+    }
+}
+
+void FeatureStatistics::Add(const DynamicVector<Real>& frame)
+{
+    Add(frame.GetData());
+}
+
+unsigned int FeatureStatistics::GetCount() const
+{
+    return mCount;
+}
+
+unsigned int FeatureStatistics::GetDimensionCount() const
+{
+    return static_cast<unsigned int>(mMeans.size());
+}
+
+void FeatureStatistics::GetMeans(DynamicVector<Real>& means) const
+{
+    if (mCount == 0)
+        std::cout << "Mean could not be calculated: no values." << std::endl;
+
+    means.Resize(GetDimensionCount());
+
+    for (unsigned int d = 0; d < GetDimensionCount(); ++d)
+        means[d] = static_cast<Real>(mMeans[d]);
+}
+
+void FeatureStatistics::GetDeviations(DynamicVector<Real>& deviations) const
+{
+    deviations.Resize(GetDimensionCount());
+
+    if (mCount < 2) {
+        std::cout << "Variance could not be calculated: not enough values."
+                  << std::endl;
+
+        deviations.Assign(0.0f);
+        return;
+    }
+
+    Accumulator invCount = 1.0f / static_cast<Accumulator>(mCount - 1);
+
+    for (unsigned int d = 0; d < GetDimensionCount(); ++d)
+        deviations[d] = static_cast<Real>(std::sqrt(mSquares[d] * invCount));
+}
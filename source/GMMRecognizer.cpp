@@ -3,9 +3,12 @@
  */
 
 #include "GMMRecognizer.h"
-#include "GMModel.h"
 
 GMMRecognizer::GMMRecognizer()
+ : mSelectionCount(0),
+   mSelected(false),
+   mScoringSamples(nullptr),
+   mBackgroundLogLikelihood(0.0f)
 {
 
 }
@@ -15,7 +18,111 @@ GMMRecognizer::~GMMRecognizer()
 
 }
 
+void GMMRecognizer::ClearTrainedData()
+{
+    ModelRecognizer::ClearTrainedData();
+
+    mStatistics.clear();
+    mStatisticsModel = nullptr;
+    mStatisticsData = nullptr;
+}
+
 std::shared_ptr<Model> GMMRecognizer::CreateModel()
 {
     return std::make_shared<GMModel>();
 }
+
+void GMMRecognizer::SetSelectionCount(unsigned int count)
+{
+    if (count != mSelectionCount) {
+        mSelectionCount = count;
+
+        Unprepare();
+    }
+}
+
+unsigned int GMMRecognizer::GetSelectionCount() const
+{
+    return mSelectionCount;
+}
+
+void GMMRecognizer::AdaptModel(const SpeakerKey& speaker,
+    const std::shared_ptr<Model>& model,
+    const std::vector< DynamicVector<Real> >& samples)
+{
+    GMModel* gmm = dynamic_cast<GMModel*>(model.get());
+    const GMModel* background = dynamic_cast<GMModel*>(GetBackgroundModel().get());
+
+    if (gmm == nullptr || background == nullptr) {
+        ModelRecognizer::AdaptModel(speaker, model, samples);
+        return;
+    }
+
+    if (GetBackgroundModel() != mStatisticsModel
+        || GetSpeakerData() != mStatisticsData) {
+        mStatistics.clear();
+        mStatisticsModel = GetBackgroundModel();
+        mStatisticsData = GetSpeakerData();
+    }
+
+    auto it = mStatistics.find(speaker);
+
+    if (it == mStatistics.end()) {
+        it = mStatistics.emplace(speaker, GMModel::Statistics()).first;
+        background->GetStatistics(samples, it->second);
+    }
+
+    gmm->Adapt(GetBackgroundModel(), it->second, samples,
+        GetAdaptationIterations(), GetRelevanceFactor());
+}
+
+void GMMRecognizer::BeginScoring(const std::vector< DynamicVector<Real> >& samples)
+{
+    mScoringSamples = nullptr;
+    mSelected = false;
+
+    if (!IsBackgroundModelEnabled())
+        return;
+
+    const GMModel* background = dynamic_cast<GMModel*>(GetBackgroundModel().get());
+
+    if (background == nullptr)
+        return;
+
+    // The components of the models correspond only if they are adapted.
+    if (mSelectionCount > 0 && IsAdaptationEnabled()) {
+        background->SelectComponents(samples, mSelectionCount, mSelection,
+            mWorkspace);
+
+        mBackgroundLogLikelihood = mSelection.logLikelihood;
+        mSelected = true;
+    } else {
+        mBackgroundLogLikelihood = background->GetLogLikelihood(samples,
+            mWorkspace);
+    }
+
+    mScoringSamples = &samples;
+}
+
+void GMMRecognizer::EndScoring()
+{
+    mScoringSamples = nullptr;
+    mSelected = false;
+}
+
+Real GMMRecognizer::GetRatio(const std::shared_ptr<Model>& model,
+    const std::vector< DynamicVector<Real> >& samples)
+{
+    const GMModel* speaker = dynamic_cast<GMModel*>(model.get());
+
+    if (mScoringSamples != &samples || speaker == nullptr)
+        return ModelRecognizer::GetRatio(model, samples);
+
+    if (mSelected) {
+        return speaker->GetLogLikelihood(samples, mSelection, mWorkspace)
+            - mBackgroundLogLikelihood;
+    }
+
+    return speaker->GetLogLikelihood(samples, mWorkspace)
+        - mBackgroundLogLikelihood;
+}
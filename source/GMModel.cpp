@@ -4,10 +4,308 @@
 
 #include "GMModel.h"
 #include "LBG.h"
+#include "Parallel.h"
+
+#include "Simd.h"
+
+namespace
+{
+    /*! \brief The number of samples scored at a time.
+     */
+    const unsigned int BlockSize = 64;
+
+    /*! \brief The number of samples per task of the E-step. The sums of
+     *  the chunks are added in chunk order, so the results do not depend
+     *  on the number of threads.
+     */
+    const unsigned int ChunkSize = 16 * BlockSize;
+
+    /*! \brief Arranges the cluster parameters for the batched kernels.
+     *
+     *  The log-likelihood of a sample x for a cluster,
+     *  log(weight) + pdfConstant - 0.5 * sum((x - mean)^2 / variance),
+     *  is expanded to sum(x * mean / variance - 0.5 * x^2 / variance)
+     *  plus a constant, so a block of samples is scored against all the
+     *  clusters with two matrix products (see MatrixMultiplyAdd()).
+     *
+     *  \param clusters The clusters, pdf constants up to date.
+     *  \param packed Output, the packed parameters.
+     */
+    void PackClusters(const std::vector<GMModel::Cluster>& clusters,
+        GMModel::PackedClusters& packed)
+    {
+        unsigned int dimensions = clusters.empty() ? 0 : clusters[0].means.GetSize();
+        unsigned int clusterCount = static_cast<unsigned int>(clusters.size());
+
+        packed.dimensions = dimensions;
+        packed.clusterCount = clusterCount;
+        packed.means.resize(dimensions * clusterCount);
+        packed.precisions.resize(dimensions * clusterCount);
+        packed.constants.resize(clusterCount);
+        packed.logWeights.resize(clusterCount);
+
+        for (unsigned int c = 0; c < clusterCount; ++c) {
+            const auto& cluster = clusters[c];
+            Accumulator constant = 0.0f;
+
+            for (unsigned int d = 0; d < dimensions; ++d) {
+                Real scaledMean = cluster.means[d] * cluster.variancesInv[d];
+
+                packed.means[d * clusterCount + c] = scaledMean;
+                packed.precisions[d * clusterCount + c] =
+                    -0.5f * cluster.variancesInv[d];
+
+                constant += scaledMean * cluster.means[d];
+            }
+
+            packed.logWeights[c] = static_cast<Real>(cluster.pdfConstant
+                + std::log(cluster.mixingCoefficient));
+            packed.constants[c] = static_cast<Real>(packed.logWeights[c]
+                - 0.5f * constant);
+        }
+    }
+
+    /*! \brief Calculates the log-likelihoods of a block of samples for each
+     *  cluster.
+     *
+     *  \param clusters The packed clusters.
+     *  \param samples The first sample of the block.
+     *  \param count The number of samples, at most BlockSize.
+     *  \param workspace Output, the samples, their squares and count x
+     *  cluster count log-likelihoods.
+     */
+    void GetLogLikelihoods(const GMModel::PackedClusters& clusters,
+        const DynamicVector<Real>* samples, unsigned int count,
+        GMModel::Workspace& workspace)
+    {
+        unsigned int dimensions = clusters.dimensions;
+        unsigned int clusterCount = clusters.clusterCount;
+
+        workspace.values.resize(BlockSize * dimensions);
+        workspace.squares.resize(BlockSize * dimensions);
+        workspace.logLikelihoods.resize(BlockSize * clusterCount);
+
+        Real* logLikelihoods = workspace.logLikelihoods.data();
+
+        for (unsigned int n = 0; n < count; ++n) {
+            const Real* values = samples[n].GetData();
+            Real* row = workspace.values.data() + n * dimensions;
+            Real* squares = workspace.squares.data() + n * dimensions;
+
+            for (unsigned int d = 0; d < dimensions; ++d) {
+                row[d] = values[d];
+                squares[d] = values[d] * values[d];
+            }
+
+            std::copy(clusters.constants.begin(), clusters.constants.end(),
+                logLikelihoods + n * clusterCount);
+        }
+
+        MatrixMultiplyAdd(logLikelihoods, workspace.values.data(),
+            clusters.means.data(), count, dimensions, clusterCount);
+        MatrixMultiplyAdd(logLikelihoods, workspace.squares.data(),
+            clusters.precisions.data(), count, dimensions, clusterCount);
+    }
+
+    /*! \brief Returns the largest of the log-likelihoods of a sample,
+     *  the offset of the log-sum-exp.
+     */
+    Accumulator GetLogMax(const Real* logLikelihoods, unsigned int count)
+    {
+        if (count == 0)
+            return -std::numeric_limits<Accumulator>::infinity();
+
+        Accumulator probMax = logLikelihoods[0];
+
+        for (unsigned int c = 1; c < count; ++c) {
+            if (logLikelihoods[c] > probMax)
+                probMax = logLikelihoods[c];
+        }
+
+        return probMax;
+    }
+
+    /*! \brief Work buffers and partial statistics of an E-step task.
+     */
+    struct ChunkState
+    {
+        GMModel::Workspace block;
+        std::vector<Accumulator> probabilities; /*!< Clusters x block size. */
+        std::vector<Accumulator> values; /*!< The block in double precision. */
+        std::vector<Accumulator> squares;
+        GMModel::Statistics statistics;
+
+        ChunkState(unsigned int dimensions, unsigned int clusterCount,
+            bool secondOrder)
+            : probabilities(clusterCount * BlockSize),
+            values(BlockSize * dimensions),
+            squares(BlockSize * dimensions)
+        {
+            statistics.Resize(dimensions, clusterCount, secondOrder);
+        }
+    };
+
+    /*! \brief Accumulates the statistics of consecutive samples.
+     *
+     *  The sums over samples are matrix products of the transposed
+     *  membership probabilities and a block of samples.
+     *
+     *  \param samples The first sample.
+     *  \param count The number of samples.
+     *  \param clusters The packed clusters.
+     *  \param state Work buffers, the sums are added to its statistics.
+     */
+    void AccumulateChunk(const DynamicVector<Real>* samples, unsigned int count,
+        const GMModel::PackedClusters& clusters, ChunkState& state)
+    {
+        unsigned int dimensions = clusters.dimensions;
+        unsigned int clusterCount = clusters.clusterCount;
+        GMModel::Statistics& statistics = state.statistics;
+        bool secondOrder = !statistics.secondOrder.empty();
+
+        for (unsigned int first = 0; first < count; first += BlockSize) {
+            unsigned int size = Min(BlockSize, count - first);
+
+            GetLogLikelihoods(clusters, samples + first, size, state.block);
+
+            // Clusters x samples.
+            for (unsigned int n = 0; n < size; ++n) {
+                const Real* row = state.block.logLikelihoods.data()
+                    + n * clusterCount;
+                Accumulator* probabilities = state.probabilities.data() + n;
+
+                // Using LSE for numerical stability.
+                Accumulator probMax = GetLogMax(row, clusterCount);
+                Accumulator probSumExp = 0.0f;
+
+                for (unsigned int c = 0; c < clusterCount; ++c) {
+                    Accumulator probability = std::exp(row[c] - probMax);
+
+                    probabilities[c * size] = probability;
+                    probSumExp += probability;
+                }
+
+                // P(k|x_n) = exp(l_k - max) / sum(exp(l_j - max)).
+                Accumulator invSumExp = 1.0f / probSumExp;
+
+                for (unsigned int c = 0; c < clusterCount; ++c) {
+                    probabilities[c * size] *= invSumExp;
+                    statistics.zeroOrder[c] += probabilities[c * size];
+                }
+
+                statistics.logLikelihood += probMax + std::log(probSumExp);
+            }
+
+            statistics.sampleCount += size;
+
+            std::copy(state.block.values.begin(), state.block.values.begin()
+                + size * dimensions, state.values.begin());
+
+            MatrixMultiplyAdd(statistics.firstOrder.data(),
+                state.probabilities.data(), state.values.data(),
+                clusterCount, size, dimensions);
+
+            if (secondOrder) {
+                std::copy(state.block.squares.begin(), state.block.squares.begin()
+                    + size * dimensions, state.squares.begin());
+
+                MatrixMultiplyAdd(statistics.secondOrder.data(),
+                    state.probabilities.data(), state.squares.data(),
+                    clusterCount, size, dimensions);
+            }
+        }
+    }
+
+    /*! \brief Calculates the Baum-Welch statistics of samples.
+     *
+     *  Chunks of samples are processed concurrently, each task with its
+     *  own statistics, which are then added in chunk order.
+     *
+     *  \param samples Samples of independent observations.
+     *  \param clusters The packed clusters.
+     *  \param secondOrder Accumulate the sums of squares too.
+     *  \param threads The maximum number of threads, 0 for all.
+     *  \param statistics Output, the statistics over the samples.
+     */
+    void AccumulateStatistics(const std::vector< DynamicVector<Real> >& samples,
+        const GMModel::PackedClusters& clusters, bool secondOrder,
+        unsigned int threads, GMModel::Statistics& statistics)
+    {
+        unsigned int dimensions = clusters.dimensions;
+        unsigned int clusterCount = clusters.clusterCount;
+        unsigned int sampleCount = static_cast<unsigned int>(samples.size());
+        unsigned int chunkCount = (sampleCount + ChunkSize - 1) / ChunkSize;
+
+        statistics.Resize(dimensions, clusterCount, secondOrder);
+        statistics.Clear();
+
+        if (threads == 0)
+            threads = GetThreadCount();
+
+        // A few chunks per thread at a time, reduced after each round.
+        unsigned int slotCount = Max(Min(chunkCount, 4 * threads), 1u);
+
+        std::vector<ChunkState> states(slotCount,
+            ChunkState(dimensions, clusterCount, secondOrder));
+
+        for (unsigned int round = 0; round < chunkCount; round += slotCount) {
+            unsigned int count = Min(slotCount, chunkCount - round);
+
+            ParallelFor(count, [&](unsigned int i) {
+                unsigned int first = (round + i) * ChunkSize;
+
+                states[i].statistics.Clear();
+
+                AccumulateChunk(&samples[first],
+                    Min(ChunkSize, sampleCount - first), clusters, states[i]);
+            }, threads);
+
+            for (unsigned int i = 0; i < count; ++i)
+                statistics.Add(states[i].statistics);
+        }
+    }
+}
+
+GMModel::Statistics::Statistics()
+    : logLikelihood(0.0f),
+    sampleCount(0)
+{
+
+}
+
+void GMModel::Statistics::Resize(unsigned int dimensions,
+    unsigned int clusterCount, bool squares)
+{
+    zeroOrder.resize(clusterCount);
+    firstOrder.resize(clusterCount * dimensions);
+    secondOrder.resize(squares ? clusterCount * dimensions : 0);
+}
+
+void GMModel::Statistics::Clear()
+{
+    std::fill(zeroOrder.begin(), zeroOrder.end(), 0.0f);
+    std::fill(firstOrder.begin(), firstOrder.end(), 0.0f);
+    std::fill(secondOrder.begin(), secondOrder.end(), 0.0f);
+    logLikelihood = 0.0f;
+    sampleCount = 0;
+}
+
+void GMModel::Statistics::Add(const Statistics& other)
+{
+    VectorAdd(zeroOrder.data(), other.zeroOrder.data(),
+        static_cast<unsigned int>(zeroOrder.size()));
+    VectorAdd(firstOrder.data(), other.firstOrder.data(),
+        static_cast<unsigned int>(firstOrder.size()));
+    VectorAdd(secondOrder.data(), other.secondOrder.data(),
+        static_cast<unsigned int>(secondOrder.size()));
+    logLikelihood += other.logLikelihood;
+    sampleCount += other.sampleCount;
+}
 
 GMModel::GMModel()
 : mTrainingIterations(75),
-  mEta(0.001f)
+  mEta(0.001f),
+  mTrainingThreads(0)
 {
 
 }
@@ -31,11 +329,32 @@ void GMModel::Train(
     Init();
     InitClusters(samples);
     EM(samples);
+
+    PackClusters(mClusters, mPackedClusters);
 }
 
 void GMModel::Adapt(const std::shared_ptr<Model>& other,
     const std::vector< DynamicVector<Real> >& samples,
     unsigned int iterations, Real relevanceFactor)
+{
+    const GMModel* model = dynamic_cast<GMModel*>(other.get());
+
+    if (model == nullptr) {
+        std::cout << "Not GMModel." << std::endl;
+        return;
+    }
+
+    Statistics statistics;
+
+    model->GetStatistics(samples, statistics);
+
+    Adapt(other, statistics, samples, iterations, relevanceFactor);
+}
+
+void GMModel::Adapt(const std::shared_ptr<Model>& other,
+    const Statistics& statistics,
+    const std::vector< DynamicVector<Real> >& samples,
+    unsigned int iterations, Real relevanceFactor)
 {
     // Following:
     // Reynolds DA, Quatieri TF & Dunn RB (2000) Speaker Verification Using
@@ -48,118 +367,219 @@ void GMModel::Adapt(const std::shared_ptr<Model>& other,
         return;
     }
 
+    unsigned int dimensions = model->GetDimensionCount();
+
+    if (statistics.zeroOrder.size() != other->GetOrder()
+        || statistics.firstOrder.size() != other->GetOrder() * dimensions) {
+        std::cout << "Statistics do not match the model." << std::endl;
+        return;
+    }
+
     SetOrder(other->GetOrder());
     Init();
+    AllocateClusters(dimensions);
 
     for (unsigned int c = 0; c < GetOrder(); c++) {
-        mClusters[c].means = model->mClusters[c].means;
-        mClusters[c].variances = model->mClusters[c].variances;
+        mClusters[c].means.Assign(model->mClusters[c].means);
+        mClusters[c].variances.Assign(model->mClusters[c].variances);
         mClusters[c].mixingCoefficient = model->mClusters[c].mixingCoefficient;
 
-        mClusters[c].meansTmp = model->mClusters[c].meansTmp;
-        mClusters[c].variancesTmp = model->mClusters[c].variancesTmp;
-        mClusters[c].variancesInv = model->mClusters[c].variancesInv;
+        mClusters[c].meansTmp.Assign(model->mClusters[c].meansTmp);
+        mClusters[c].variancesTmp.Assign(model->mClusters[c].variancesTmp);
+        mClusters[c].variancesInv.Assign(model->mClusters[c].variancesInv);
     }
 
     for (auto& cluster : mClusters)
         UpdatePDF(cluster);
 
-    Real logLikelihood = 0.0f;
-    Real newLogLikelihood = 0.0f;
+    Accumulator logLikelihood = 0.0f;
+    Statistics current;
 
     for (unsigned int e = 0; e < iterations; ++e) {
-        for (auto& cluster : mClusters) {
-            cluster.membershipProbabilitySum = 0.0f;
-            cluster.meansTmp.Assign(0.0f);
-        }
+        // The first iteration is against the background model.
+        const Statistics* iteration = &statistics;
 
-        Real newLogLikelihood = 0.0f;
+        if (e > 0) {
+            if (samples.empty())
+                break;
 
-        for (const auto& sample : samples) {
-            // Using LSE for numerical stability.
-            Real probMax = std::numeric_limits<Real>::min();
-            Real probSumExp = 0.0f;
-            Real probLogSumExp = 0.0f;
-
-            for (auto& cluster : mClusters) {
-                cluster.membershipProbability = GetLogLikelihood(sample, cluster);
-                if (cluster.membershipProbability > probMax)
-                    probMax = cluster.membershipProbability;
-            }
+            PackClusters(mClusters, mPackedClusters);
+            AccumulateStatistics(samples, mPackedClusters, false,
+                mTrainingThreads, current);
 
-            for (const auto& cluster : mClusters)
-                probSumExp += std::exp(cluster.membershipProbability - probMax);
-
-            probLogSumExp = probMax + std::log(probSumExp);
-
-            for (auto& cluster : mClusters) {
-                // Calculate the final membership probability.
-                cluster.membershipProbability = std::exp(
-                    cluster.membershipProbability - probLogSumExp);
-                // Calculate the final sum of membership probabilities.
-                cluster.membershipProbabilitySum += cluster.membershipProbability;
-                for (unsigned int d = 0; d < cluster.means.GetSize(); ++d) {
-                    // Mean sum(p*x)
-                    cluster.meansTmp[d] +=
-                        sample[d] * cluster.membershipProbability;
-                }
-            }
-
-            newLogLikelihood += probLogSumExp;
+            iteration = &current;
         }
 
-        for (auto& cluster : mClusters) {
-            Real n = cluster.membershipProbabilitySum;
-            Real adaptionCoeff = n / (n + relevanceFactor);
-
-            for (unsigned int d = 0; d < mClusters[0].means.GetSize(); ++d) {
-                cluster.means[d] = adaptionCoeff * (cluster.meansTmp[d] / n) +
-                    (1.0f - adaptionCoeff) * cluster.means[d];
-            }
-
-            UpdatePDF(cluster);
-        }
+        AdaptMeans(*iteration, relevanceFactor);
 
-        if (std::abs(logLikelihood - newLogLikelihood) / samples.size() < mEta)
+        if (std::abs(logLikelihood - iteration->logLikelihood)
+            / statistics.sampleCount < mEta)
             break;
 
-        logLikelihood = newLogLikelihood;
+        logLikelihood = iteration->logLikelihood;
 
         std::cout << ".";
     }
 
     std::cout << std::endl;
+
+    PackClusters(mClusters, mPackedClusters);
+}
+
+void GMModel::GetStatistics(const std::vector< DynamicVector<Real> >& samples,
+    Statistics& statistics, bool secondOrder) const
+{
+    AccumulateStatistics(samples, mPackedClusters, secondOrder,
+        mTrainingThreads, statistics);
 }
 
 Real GMModel::GetLogLikelihood(const std::vector< DynamicVector<Real> >& samples) const
+{
+    Workspace workspace;
+
+    return GetLogLikelihood(samples, workspace);
+}
+
+Real GMModel::GetLogLikelihood(const std::vector< DynamicVector<Real> >& samples,
+    Workspace& workspace) const
 {
     if (samples.size() == 0)
         return 0.0f;
 
-    Real result = 0.0f;
-    Real invN = 1.0f / static_cast<Real>(samples.size());
+    unsigned int clusterCount = mPackedClusters.clusterCount;
 
-    for (const auto& sample : samples) {
-        // Using LSE for numerical stability.
-        Real probMax = std::numeric_limits<Real>::min();
-        Real probSumExp = 0.0f;
-        Real probLogSumExp = 0.0f;
+    Accumulator result = 0.0f;
+    Accumulator invN = 1.0f / static_cast<Accumulator>(samples.size());
 
-        for (auto& cluster : mClusters) {
-            // TODO get rid of this assignment. For now this is "ok" though as long
-            // as this function is called outside.
-            cluster.membershipProbability = GetLogLikelihood(sample, cluster);
+    for (unsigned int first = 0; first < samples.size(); first += BlockSize) {
+        unsigned int count = Min(BlockSize,
+            static_cast<unsigned int>(samples.size()) - first);
+
+        GetLogLikelihoods(mPackedClusters, &samples[first], count, workspace);
+
+        for (unsigned int n = 0; n < count; ++n) {
+            const Real* row = workspace.logLikelihoods.data() + n * clusterCount;
 
-            if (cluster.membershipProbability > probMax)
-                probMax = cluster.membershipProbability;
+            // Using LSE for numerical stability.
+            Accumulator probMax = GetLogMax(row, clusterCount);
+            Accumulator probSumExp = 0.0f;
+
+            for (unsigned int c = 0; c < clusterCount; ++c)
+                probSumExp += std::exp(row[c] - probMax);
+
+            result += (probMax + std::log(probSumExp)) * invN;
         }
+    }
+
+    return result;
+}
+
+void GMModel::SelectComponents(const std::vector< DynamicVector<Real> >& samples,
+    unsigned int count, Selection& selection, Workspace& workspace) const
+{
+    unsigned int clusterCount = mPackedClusters.clusterCount;
+
+    count = Min(count, clusterCount);
+
+    selection.count = count;
+    selection.clusterCount = clusterCount;
+    selection.components.resize(samples.size() * count);
+    selection.logLikelihood = 0.0f;
+
+    if (samples.size() == 0)
+        return;
+
+    Accumulator result = 0.0f;
+    Accumulator invN = 1.0f / static_cast<Accumulator>(samples.size());
+
+    for (unsigned int first = 0; first < samples.size(); first += BlockSize) {
+        unsigned int size = Min(BlockSize,
+            static_cast<unsigned int>(samples.size()) - first);
+
+        GetLogLikelihoods(mPackedClusters, &samples[first], size, workspace);
 
-        for (const auto& cluster : mClusters)
-            probSumExp += std::exp(cluster.membershipProbability - probMax);
+        for (unsigned int n = 0; n < size; ++n) {
+            const Real* row = workspace.logLikelihoods.data() + n * clusterCount;
+            unsigned int* best = selection.components.data() + (first + n) * count;
+            unsigned int selected = 0;
 
-        probLogSumExp = probMax + std::log(probSumExp);
+            // Insertion into the sorted best components, few are replaced.
+            for (unsigned int c = 0; c < clusterCount; ++c) {
+                if (selected == count && row[c] <= row[best[count - 1]])
+                    continue;
 
-        result += probLogSumExp * invN;
+                unsigned int i = (selected < count) ? selected++ : count - 1;
+
+                for (; i > 0 && row[best[i - 1]] < row[c]; --i)
+                    best[i] = best[i - 1];
+
+                best[i] = c;
+            }
+
+            // The same components as in the adapted models, the errors of
+            // leaving out the rest mostly cancel in the likelihood ratio.
+            Accumulator probMax = row[best[0]];
+            Accumulator probSumExp = 0.0f;
+
+            for (unsigned int i = 0; i < count; ++i)
+                probSumExp += std::exp(row[best[i]] - probMax);
+
+            result += (probMax + std::log(probSumExp)) * invN;
+        }
+    }
+
+    selection.logLikelihood = static_cast<Real>(result);
+}
+
+Real GMModel::GetLogLikelihood(const std::vector< DynamicVector<Real> >& samples,
+    const Selection& selection, Workspace& workspace) const
+{
+    if (selection.clusterCount != mPackedClusters.clusterCount
+        || selection.components.size() != samples.size() * selection.count) {
+        std::cout << "Component selection does not match the model." << std::endl;
+        return GetLogLikelihood(samples, workspace);
+    }
+
+    if (samples.size() == 0 || selection.count == 0)
+        return 0.0f;
+
+    unsigned int dimensions = mPackedClusters.dimensions;
+    unsigned int count = selection.count;
+
+    workspace.logLikelihoods.resize(count);
+
+    Real* logLikelihoods = workspace.logLikelihoods.data();
+
+    Accumulator result = 0.0f;
+    Accumulator invN = 1.0f / static_cast<Accumulator>(samples.size());
+
+    for (unsigned int n = 0; n < samples.size(); ++n) {
+        const Real* values = samples[n].GetData();
+        const unsigned int* components = selection.components.data() + n * count;
+
+        for (unsigned int i = 0; i < count; ++i) {
+            const Cluster& cluster = mClusters[components[i]];
+            const Real* means = cluster.means.GetData();
+            const Real* variancesInv = cluster.variancesInv.GetData();
+            Real distance = 0.0f;
+
+            for (unsigned int d = 0; d < dimensions; ++d) {
+                Real difference = values[d] - means[d];
+                distance += difference * difference * variancesInv[d];
+            }
+
+            logLikelihoods[i] = mPackedClusters.logWeights[components[i]]
+                - 0.5f * distance;
+        }
+
+        // Using LSE for numerical stability.
+        Accumulator probMax = GetLogMax(logLikelihoods, count);
+        Accumulator probSumExp = 0.0f;
+
+        for (unsigned int i = 0; i < count; ++i)
+            probSumExp += std::exp(logLikelihoods[i] - probMax);
+
+        result += (probMax + std::log(probSumExp)) * invN;
     }
 
     return result;
@@ -175,6 +595,12 @@ Real GMModel::GetLogScore(const std::vector< DynamicVector<Real> >& samples) con
     return GetLogLikelihood(samples);
 }
 
+Real GMModel::GetLogScore(const std::vector< DynamicVector<Real> >& samples,
+    Workspace& workspace) const
+{
+    return GetLogLikelihood(samples, workspace);
+}
+
 unsigned int GMModel::GetDimensionCount() const
 {
     if (mClusters.size() == 0)
@@ -183,17 +609,26 @@ unsigned int GMModel::GetDimensionCount() const
     return mClusters.begin()->means.GetSize();
 }
 
-void GMModel::InitClusters(const std::vector< DynamicVector<Real> >& samples)
+void GMModel::AllocateClusters(unsigned int dimensions)
 {
-    // Create the initial centroid by averaging sample data.
+    // All vectors of a model in a few aligned blocks instead of five
+    // allocations per cluster.
+    mPool.Release();
 
     for (auto& cluster : mClusters) {
-        cluster.means.Resize(samples[0].GetSize());
-        cluster.variances.Resize(samples[0].GetSize());
-        cluster.meansTmp.Resize(samples[0].GetSize());
-        cluster.variancesTmp.Resize(samples[0].GetSize());
-        cluster.variancesInv.Resize(samples[0].GetSize());
+        cluster.means = DynamicVector<Real>(mPool, dimensions);
+        cluster.variances = DynamicVector<Real>(mPool, dimensions);
+        cluster.meansTmp = DynamicVector<Accumulator>(mPool, dimensions);
+        cluster.variancesTmp = DynamicVector<Accumulator>(mPool, dimensions);
+        cluster.variancesInv = DynamicVector<Real>(mPool, dimensions);
     }
+}
+
+void GMModel::InitClusters(const std::vector< DynamicVector<Real> >& samples)
+{
+    // Create the initial centroid by averaging sample data.
+
+    AllocateClusters(samples[0].GetSize());
 
     std::vector<unsigned int> indices;
     std::vector< DynamicVector<Real> > centroids;
@@ -217,10 +652,14 @@ void GMModel::InitClusters(const std::vector< DynamicVector<Real> >& samples)
 
     for (auto& cluster : mClusters) {
         for (unsigned int d = 0; d < mClusters[0].means.GetSize(); ++d) {
+            Accumulator variance = cluster.variances[d];
+
             for (const auto& sample : samples) {
-                cluster.variances[d] += (cluster.means[d] - sample[d])
+                variance += (cluster.means[d] - sample[d])
                     * (cluster.means[d] - sample[d]) / samples.size();
             }
+
+            cluster.variances[d] = variance;
         }
     }
 }
@@ -245,6 +684,16 @@ Real GMModel::GetTrainingThreshold() const
     return mEta;
 }
 
+void GMModel::SetTrainingThreads(unsigned int threads)
+{
+    mTrainingThreads = threads;
+}
+
+unsigned int GMModel::GetTrainingThreads() const
+{
+    return mTrainingThreads;
+}
+
 void GMModel::EM(const std::vector< DynamicVector<Real> >& samples)
 {
     // Following:
@@ -258,8 +707,8 @@ void GMModel::EM(const std::vector< DynamicVector<Real> >& samples)
         UpdatePDF(cluster);
     }
 
-    Real logLikelihood = 0.0f;
-    Real newLogLikelihood = 0.0f;
+    Accumulator logLikelihood = 0.0f;
+    Accumulator newLogLikelihood = 0.0f;
 
     for (unsigned int e = 0; e < mTrainingIterations; ++e) {
         //std::cout << "Iteration:" << e << std::endl;
@@ -282,52 +731,35 @@ void GMModel::EM(const std::vector< DynamicVector<Real> >& samples)
     std::cout << std::endl;
 }
 
-Real GMModel::E(const std::vector< DynamicVector<Real> >& samples)
+Accumulator GMModel::E(const std::vector< DynamicVector<Real> >& samples)
 {
-    Real newLogLikelihood = 0.0f;
+    Statistics statistics;
 
-    for (const auto& sample : samples) {
-        // Using LSE for numerical stability.
-        Real probMax = std::numeric_limits<Real>::min();
-        Real probSumExp = 0.0f;
-        Real probLogSumExp = 0.0f;
+    PackClusters(mClusters, mPackedClusters);
+    AccumulateStatistics(samples, mPackedClusters, true, mTrainingThreads,
+        statistics);
 
-        for (auto& cluster : mClusters) {
-            cluster.membershipProbability = GetLogLikelihood(sample, cluster);
-            if (cluster.membershipProbability > probMax)
-                probMax = cluster.membershipProbability;
-        }
+    unsigned int dimensions = mPackedClusters.dimensions;
 
-        for (const auto& cluster : mClusters)
-            probSumExp += std::exp(cluster.membershipProbability - probMax);
+    for (unsigned int c = 0; c < mClusters.size(); ++c) {
+        Cluster& cluster = mClusters[c];
 
-        probLogSumExp = probMax + std::log(probSumExp);
+        cluster.membershipProbabilitySum += statistics.zeroOrder[c];
 
-        for (auto& cluster : mClusters) {
-            // Calculate the final membership probability.
-            cluster.membershipProbability = std::exp(
-                cluster.membershipProbability - probLogSumExp);
-            // Calculate the final sum of membership probabilities.
-            cluster.membershipProbabilitySum += cluster.membershipProbability;
-            for (unsigned int d = 0; d < cluster.means.GetSize(); ++d) {
-                // Mean sum(p*x)
-                 cluster.meansTmp[d] += sample[d] * cluster.membershipProbability;
-                // Variance sum(p*x^2) (- mu^2)
-                cluster.variancesTmp[d] += sample[d] * sample[d]
-                    * cluster.membershipProbability;
-            }
+        for (unsigned int d = 0; d < dimensions; ++d) {
+            cluster.meansTmp[d] += statistics.firstOrder[c * dimensions + d];
+            cluster.variancesTmp[d] += statistics.secondOrder[c * dimensions + d];
         }
-
-        newLogLikelihood += probLogSumExp;
     }
 
-    return newLogLikelihood;
+    return statistics.logLikelihood;
 }
 
 void GMModel::M(const std::vector< DynamicVector<Real> >& samples)
 {
     for (auto& cluster : mClusters) {
-        Real invMembershipProbabilitySum = 1.0f / cluster.membershipProbabilitySum;
+        Accumulator invMembershipProbabilitySum =
+            1.0f / cluster.membershipProbabilitySum;
 
         for (unsigned int d = 0; d < mClusters[0].means.GetSize(); ++d) {
             cluster.means[d] = cluster.meansTmp[d] * invMembershipProbabilitySum;
@@ -343,23 +775,30 @@ void GMModel::M(const std::vector< DynamicVector<Real> >& samples)
         }
 
         cluster.mixingCoefficient = cluster.membershipProbabilitySum
-            / static_cast<Real>(samples.size());
+            / static_cast<Accumulator>(samples.size());
 
         UpdatePDF(cluster);
     }
 }
 
-Real GMModel::GetLogLikelihood(const DynamicVector<Real>& values,
-    const Cluster& cluster) const
+void GMModel::AdaptMeans(const Statistics& statistics, Real relevanceFactor)
 {
-    Real v = 0.0f;
+    unsigned int dimensions = GetDimensionCount();
 
-    for (unsigned int d = 0; d < mClusters[0].means.GetSize(); ++d) {
-        Real tmp = values[d] - cluster.means[d];
-        v += tmp * tmp * cluster.variancesInv[d];
-    }
+    for (unsigned int c = 0; c < mClusters.size(); ++c) {
+        Cluster& cluster = mClusters[c];
+        const Accumulator* sums = statistics.firstOrder.data() + c * dimensions;
+
+        Accumulator n = statistics.zeroOrder[c];
+        Accumulator adaptionCoeff = n / (n + relevanceFactor);
+
+        for (unsigned int d = 0; d < dimensions; ++d) {
+            cluster.means[d] = adaptionCoeff * (sums[d] / n) +
+                (1.0f - adaptionCoeff) * cluster.means[d];
+        }
 
-    return (cluster.pdfConstant - 0.5f * v) + std::log(cluster.mixingCoefficient);
+        UpdatePDF(cluster);
+    }
 }
 
 void GMModel::UpdatePDF(Cluster& cluster)
@@ -368,7 +807,7 @@ void GMModel::UpdatePDF(Cluster& cluster)
         cluster.variancesInv[d] = 1.0f / cluster.variances[d];
 
     // Determinant
-    Real constant = 1.0;
+    Accumulator constant = 1.0;
     for (unsigned int d = 0; d < mClusters[0].means.GetSize(); ++d)
         constant *= cluster.variances[d];
 
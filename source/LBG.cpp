@@ -4,6 +4,8 @@
 
 #include "LBG.h"
 
+#include "CentroidSearch.h"
+
 LBG::LBG(unsigned int clusterCount, Real eta)
     : mClusterCount(clusterCount), mEta(eta)
 {
@@ -40,26 +42,36 @@ void LBG::Cluster(
     if (sizes.size() != mClusterCount)
         sizes.resize(mClusterCount);
 
+    unsigned int dimensions = samples[0].GetSize();
+
     // Initialize the feature vectors of the centroids.
     for (auto& centroid : centroids)
-        centroid.Resize(samples[0].GetSize(), 0.0f);
+        centroid.Resize(dimensions, 0.0f);
+
+    // Centroid sums.
+    std::vector< DynamicVector<Accumulator> > sums(mClusterCount,
+        DynamicVector<Accumulator>(dimensions));
 
     // Create the initial centroid by averaging sample data.
-    centroids[0].Assign(0.0f);
-    for (const auto& sample : samples)
-        centroids[0].Add(sample);
+    for (const auto& sample : samples) {
+        for (unsigned int d = 0; d < dimensions; ++d)
+            sums[0][d] += sample[d];
+    }
+
+    Accumulator invSize = 1.0f / static_cast<Accumulator>(samples.size());
 
-    centroids[0].Multiply(1.0f / static_cast<Real>(samples.size()));
+    for (unsigned int d = 0; d < dimensions; ++d)
+        centroids[0][d] = static_cast<Real>(sums[0][d] * invSize);
 
     // Cluster counter.
     unsigned int n = 1;
     // Average distortion.
-    Real avgDist = 0.0f;
+    Accumulator avgDist = 0.0f;
 
     for (const auto& sample : samples)
         avgDist += sample.Distance(centroids[0]);
 
-    avgDist /= static_cast<Real>(samples.size() * centroids[0].GetSize());
+    avgDist /= static_cast<Accumulator>(samples.size() * dimensions);
 
     do {
         for (unsigned int c = 0; c < n; ++c)
@@ -69,41 +81,40 @@ void LBG::Cluster(
 
         while (true) {
             // Find closest centroid for each sample.
-            for (unsigned int s = 0; s < samples.size(); ++s) {
-                Real minDist = std::numeric_limits<Real>::max();
-                unsigned int minC = -1;
-                for (unsigned int c = 0; c < n; ++c) {
-                    Real dist = samples[s].Distance(centroids[c]);
-                    if (dist < minDist) {
-                        minDist = dist;
-                        minC = c;
-                    }
-                }
-                indices[s] = minC;
-            }
+            CentroidSearch search(centroids, n);
+
+            for (unsigned int s = 0; s < samples.size(); ++s)
+                indices[s] = search.Find(samples[s]);
 
             // Update centroids.
             for (unsigned int c = 0; c < n; ++c) {
-                centroids[c].Assign(0.0f);
+                sums[c].Assign(0.0f);
                 sizes[c] = 0;
             }
 
             for (unsigned int s = 0; s < samples.size(); ++s) {
-                centroids[indices[s]].Add(samples[s]);
+                auto& sum = sums[indices[s]];
+
+                for (unsigned int d = 0; d < dimensions; ++d)
+                    sum[d] += samples[s][d];
+
                 ++sizes[indices[s]];
             }
 
             for (unsigned int c = 0; c < n; ++c) {
-                if (sizes[c] > 0)
-                    centroids[c].Multiply(1.0f / static_cast<Real>(sizes[c]));
+                Accumulator invSize = (sizes[c] > 0)
+                    ? 1.0f / static_cast<Accumulator>(sizes[c]) : 0.0f;
+
+                for (unsigned int d = 0; d < dimensions; ++d)
+                    centroids[c][d] = static_cast<Real>(sums[c][d] * invSize);
             }
 
-            Real newAvgDist = 0.0f;
+            Accumulator newAvgDist = 0.0f;
 
             for (unsigned int s = 0; s < samples.size(); ++s)
                 newAvgDist += samples[s].Distance(centroids[indices[s]]);
 
-            newAvgDist /= static_cast<Real>(samples.size() * centroids[0].GetSize());
+            newAvgDist /= static_cast<Accumulator>(samples.size() * dimensions);
 
             if (((avgDist - newAvgDist) / avgDist) > mEta) {
                 avgDist = newAvgDist;
@@ -0,0 +1,199 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "LPC.h"
+
+namespace
+{
+    /*! \brief Returns the number of samples in a given time (rounded).
+     */
+    unsigned int GetSampleCount(Real seconds, unsigned int sampleRate)
+    {
+        return static_cast<unsigned int>(
+            std::floor(static_cast<double>(seconds) * sampleRate + 0.5));
+    }
+}
+
+LPC::LPC()
+{
+    SetParameters(Parameters());
+}
+
+LPC::LPC(const Parameters& parameters)
+{
+    SetParameters(parameters);
+}
+
+LPC::~LPC()
+{
+
+}
+
+void LPC::SetParameters(const Parameters& parameters)
+{
+    mParameters = parameters;
+
+    mAutocorrelation.resize(mParameters.order + 1);
+    mPolynomial.resize(mParameters.order + 1);
+    mPrevious.resize(mParameters.order + 1);
+    mCepstrum.resize(mParameters.cepstrumCount);
+}
+
+const LPC::Parameters& LPC::GetParameters() const
+{
+    return mParameters;
+}
+
+unsigned int LPC::GetColumnCount() const
+{
+    return (mParameters.cepstrumCount > 0)
+        ? mParameters.cepstrumCount : mParameters.order + 1;
+}
+
+unsigned int LPC::GetFrameCount(unsigned int length,
+    unsigned int sampleRate) const
+{
+    unsigned int frameLength = GetSampleCount(mParameters.frameLength, sampleRate);
+    unsigned int frameStep = GetSampleCount(mParameters.frameStep, sampleRate);
+
+    if (length <= frameLength || frameStep == 0)
+        return 1;
+
+    return 1 + (length - frameLength + frameStep - 1) / frameStep;
+}
+
+void LPC::Compute(const Real* signal, unsigned int length,
+    unsigned int sampleRate, FeatureMatrix& features)
+{
+    unsigned int frameCount = GetFrameCount(length, sampleRate);
+
+    features.Clear(GetColumnCount());
+
+    ComputeFrames(signal, 0, length, sampleRate, 0, frameCount,
+        features.AppendRows(frameCount));
+}
+
+void LPC::Compute(const WaveFile& file, FeatureMatrix& features,
+    unsigned int chunkFrames)
+{
+    unsigned int sampleRate = file.GetSampleRate();
+    unsigned int length = file.GetLength();
+
+    unsigned int frameLength = GetSampleCount(mParameters.frameLength, sampleRate);
+    unsigned int frameStep = GetSampleCount(mParameters.frameStep, sampleRate);
+    unsigned int frameCount = GetFrameCount(length, sampleRate);
+
+    if (chunkFrames == 0)
+        chunkFrames = DefaultChunkFrames;
+
+    features.Clear(GetColumnCount());
+    features.Reserve(frameCount);
+
+    std::vector<Real> samples;
+
+    for (unsigned int first = 0; first < frameCount; first += chunkFrames) {
+        unsigned int count = Min(chunkFrames, frameCount - first);
+        unsigned int begin = Min(length, first * frameStep);
+        unsigned int end = Min(length, (first + count - 1) * frameStep + frameLength);
+
+        samples.resize(end - begin);
+
+        if (!samples.empty())
+            file.Read(begin, end - begin, samples.data());
+
+        ComputeFrames(samples.data(), begin, length, sampleRate, first, count,
+            features.AppendRows(count));
+    }
+}
+
+void LPC::ComputeFrames(const Real* signal, unsigned int offset,
+    unsigned int length, unsigned int sampleRate, unsigned int firstFrame,
+    unsigned int frameCount, Real* coefficients)
+{
+    unsigned int frameLength = GetSampleCount(mParameters.frameLength, sampleRate);
+    unsigned int frameStep = GetSampleCount(mParameters.frameStep, sampleRate);
+    unsigned int columns = GetColumnCount();
+
+    for (unsigned int f = firstFrame; f < firstFrame + frameCount; ++f) {
+        unsigned int start = f * frameStep;
+        unsigned int available = (start < length)
+            ? Min(frameLength, length - start) : 0;
+
+        ComputeFrame(signal + (start < length ? start - offset : 0), available,
+            frameLength, coefficients);
+
+        coefficients += columns;
+    }
+}
+
+void LPC::ComputeFrame(const Real* frame, unsigned int available,
+    unsigned int frameLength, Real* coefficients)
+{
+    unsigned int order = mParameters.order;
+    Accumulator* r = mAutocorrelation.data();
+    Accumulator* a = mPolynomial.data();
+    Accumulator* previous = mPrevious.data();
+
+    // Biased autocorrelation over the zero padded frame (as talkbox on
+    // framesig frames), the padding adds nothing to the sums.
+    for (unsigned int lag = 0; lag <= order; ++lag) {
+        Accumulator sum = 0.0f;
+
+        for (unsigned int i = lag; i < available; ++i)
+            sum += static_cast<Accumulator>(frame[i]) * frame[i - lag];
+
+        r[lag] = (frameLength > 0) ? sum / frameLength : 0.0f;
+    }
+
+    for (unsigned int i = 0; i <= order; ++i)
+        a[i] = 0.0f;
+
+    a[0] = 1.0f;
+
+    // Levinson-Durbin, a silent frame keeps the trivial predictor.
+    Accumulator error = r[0];
+
+    for (unsigned int i = 1; i <= order && error > 0.0f; ++i) {
+        Accumulator sum = r[i];
+
+        for (unsigned int j = 1; j < i; ++j)
+            sum += a[j] * r[i - j];
+
+        Accumulator k = -sum / error;
+
+        for (unsigned int j = 0; j < i; ++j)
+            previous[j] = a[j];
+
+        for (unsigned int j = 1; j < i; ++j)
+            a[j] = previous[j] + k * previous[i - j];
+
+        a[i] = k;
+        error *= 1.0f - k * k;
+    }
+
+    if (mParameters.cepstrumCount == 0) {
+        for (unsigned int i = 0; i <= order; ++i)
+            coefficients[i] = static_cast<Real>(a[i]);
+
+        return;
+    }
+
+    // Cepstrum of the all-pole model G / A(z), G^2 being the error.
+    Accumulator* c = mCepstrum.data();
+
+    c[0] = std::log(Max(error, static_cast<Accumulator>(
+        std::numeric_limits<double>::epsilon())));
+
+    for (unsigned int n = 1; n < mParameters.cepstrumCount; ++n) {
+        Accumulator sum = (n <= order) ? a[n] : 0.0f;
+
+        for (unsigned int k = (n > order) ? n - order : 1; k < n; ++k)
+            sum += (static_cast<Accumulator>(k) / n) * c[k] * a[n - k];
+
+        c[n] = -sum;
+    }
+
+    for (unsigned int n = 0; n < mParameters.cepstrumCount; ++n)
+        coefficients[n] = static_cast<Real>(c[n]);
+}
@@ -0,0 +1,135 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "LineIndex.h"
+
+#include <cstring>
+
+std::string GetLineIndexPath(const std::string& textPath)
+{
+    return textPath + ".idx";
+}
+
+LineIndex::LineIndex()
+    : mOffsets(nullptr),
+    mLineCount(0)
+{
+
+}
+
+LineIndex::~LineIndex()
+{
+
+}
+
+bool LineIndex::Open(const std::string& path)
+{
+    Close();
+
+    Header header;
+    std::memcpy(header.magic, "SOPI", 4);
+    header.version = Version;
+    header.lineCount = 0;
+
+    if (!GetFileStatus(path, header.fileSize, header.fileTime))
+        return false;
+
+    std::string indexPath = GetLineIndexPath(path);
+
+    if (mFile.Open(indexPath) && mFile.GetSize() >= sizeof(Header)) {
+        const Header* stored = reinterpret_cast<const Header*>(mFile.GetData());
+
+        if (std::memcmp(stored->magic, header.magic, 4) == 0
+            && stored->version == header.version
+            && stored->fileSize == header.fileSize
+            && stored->fileTime == header.fileTime
+            && mFile.GetSize() == sizeof(Header)
+                + stored->lineCount * sizeof(uint64_t)) {
+            mOffsets = reinterpret_cast<const uint64_t*>(
+                mFile.GetData() + sizeof(Header));
+            mLineCount = static_cast<unsigned int>(stored->lineCount);
+
+            return true;
+        }
+    }
+
+    // Missing or stale index.
+    mFile.Close();
+
+    if (!Build(path, header))
+        return false;
+
+    std::ofstream out(indexPath, std::ios::binary | std::ios::trunc);
+
+    if (out.good()) {
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(mBuiltOffsets.data()),
+            mBuiltOffsets.size() * sizeof(uint64_t));
+    }
+
+    if (!out.good()) {
+        // The index is still usable in memory.
+        std::cout << "Could not save line index '" << indexPath << "'."
+            << std::endl;
+    }
+
+    return true;
+}
+
+void LineIndex::Close()
+{
+    mFile.Close();
+    mBuiltOffsets.clear();
+    mOffsets = nullptr;
+    mLineCount = 0;
+}
+
+unsigned int LineIndex::GetLineCount() const
+{
+    return mLineCount;
+}
+
+uint64_t LineIndex::GetOffset(unsigned int line) const
+{
+    return mOffsets[line - 1];
+}
+
+bool LineIndex::Build(const std::string& path, Header& header)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.good())
+        return false;
+
+    std::cout << "Indexing lines: " << path << std::endl;
+
+    std::vector<char> buffer(1 << 16);
+    uint64_t position = 0;
+    bool lineStart = true;
+
+    mBuiltOffsets.clear();
+
+    while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0) {
+        std::size_t count = static_cast<std::size_t>(file.gcount());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (lineStart) {
+                mBuiltOffsets.push_back(position + i);
+                lineStart = false;
+            }
+
+            if (buffer[i] == '\n')
+                lineStart = true;
+        }
+
+        position += count;
+    }
+
+    header.lineCount = mBuiltOffsets.size();
+
+    mOffsets = mBuiltOffsets.data();
+    mLineCount = static_cast<unsigned int>(mBuiltOffsets.size());
+
+    return true;
+}
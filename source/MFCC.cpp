@@ -0,0 +1,302 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "MFCC.h"
+#include "Simd.h"
+
+namespace
+{
+    const double Pi = 3.14159265358979323846;
+
+    // Frames per block in the filterbank and DCT matrix products.
+    const unsigned int BlockFrames = 64;
+
+    double HzToMel(double hz)
+    {
+        return 2595.0 * std::log10(1.0 + hz / 700.0);
+    }
+
+    double MelToHz(double mel)
+    {
+        return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0);
+    }
+
+    /*! \brief Returns the number of samples in a given time (rounded).
+     */
+    unsigned int GetSampleCount(Real seconds, unsigned int sampleRate)
+    {
+        return static_cast<unsigned int>(
+            std::floor(static_cast<double>(seconds) * sampleRate + 0.5));
+    }
+}
+
+MFCC::MFCC()
+    : mSampleRate(0)
+{
+    SetParameters(Parameters());
+}
+
+MFCC::MFCC(const Parameters& parameters)
+    : mSampleRate(0)
+{
+    SetParameters(parameters);
+}
+
+MFCC::~MFCC()
+{
+
+}
+
+void MFCC::SetParameters(const Parameters& parameters)
+{
+    mParameters = parameters;
+    mSampleRate = 0;
+
+    mFFT.SetSize(mParameters.fftSize);
+
+    mFrame.resize(mParameters.fftSize);
+    mSpectrum.resize(mParameters.fftSize / 2 + 1);
+    mPower.resize(BlockFrames * mSpectrum.size());
+    mFrameEnergies.resize(BlockFrames);
+    mEnergies.resize(BlockFrames * mParameters.filterCount);
+    mCoefficients.resize(BlockFrames * mParameters.cepstrumCount);
+}
+
+const MFCC::Parameters& MFCC::GetParameters() const
+{
+    return mParameters;
+}
+
+unsigned int MFCC::GetFrameCount(unsigned int length,
+    unsigned int sampleRate) const
+{
+    unsigned int frameLength = GetSampleCount(mParameters.frameLength, sampleRate);
+    unsigned int frameStep = GetSampleCount(mParameters.frameStep, sampleRate);
+
+    if (length <= frameLength || frameStep == 0)
+        return 1;
+
+    return 1 + (length - frameLength + frameStep - 1) / frameStep;
+}
+
+void MFCC::Compute(const Real* signal, unsigned int length,
+    unsigned int sampleRate, FeatureMatrix& features)
+{
+    if (sampleRate != mSampleRate)
+        Prepare(sampleRate);
+
+    unsigned int frameCount = GetFrameCount(length, sampleRate);
+
+    features.Clear(mParameters.cepstrumCount);
+
+    ComputeFrames(signal, 0, length, 0, frameCount,
+        features.AppendRows(frameCount));
+}
+
+void MFCC::Compute(const WaveFile& file, FeatureMatrix& features,
+    unsigned int chunkFrames)
+{
+    unsigned int sampleRate = file.GetSampleRate();
+    unsigned int length = file.GetLength();
+
+    if (sampleRate != mSampleRate)
+        Prepare(sampleRate);
+
+    unsigned int frameLength = GetSampleCount(mParameters.frameLength, sampleRate);
+    unsigned int frameStep = GetSampleCount(mParameters.frameStep, sampleRate);
+    unsigned int frameCount = GetFrameCount(length, sampleRate);
+    unsigned int used = Min(frameLength, mParameters.fftSize);
+
+    if (chunkFrames == 0)
+        chunkFrames = DefaultChunkFrames;
+
+    features.Clear(mParameters.cepstrumCount);
+    features.Reserve(frameCount);
+
+    std::vector<Real> samples;
+
+    for (unsigned int first = 0; first < frameCount; first += chunkFrames) {
+        unsigned int count = Min(chunkFrames, frameCount - first);
+
+        // Include the sample before the chunk for pre-emphasis.
+        unsigned int start = first * frameStep;
+        unsigned int begin = (start > 0) ? start - 1 : 0;
+        unsigned int end = Min(length, (first + count - 1) * frameStep + used);
+
+        samples.resize(end > begin ? end - begin : 0);
+
+        if (!samples.empty())
+            file.Read(begin, end - begin, samples.data());
+
+        ComputeFrames(samples.data(), begin, length, first, count,
+            features.AppendRows(count));
+    }
+}
+
+void MFCC::ComputeFrames(const Real* signal, unsigned int offset,
+    unsigned int length, unsigned int firstFrame, unsigned int frameCount,
+    Real* coefficients)
+{
+    unsigned int frameLength = GetSampleCount(mParameters.frameLength, mSampleRate);
+    unsigned int frameStep = GetSampleCount(mParameters.frameStep, mSampleRate);
+
+    // Frames longer than the FFT are truncated, shorter are zero padded.
+    unsigned int used = Min(frameLength, mParameters.fftSize);
+    Real preemphasis = mParameters.preemphasis;
+
+    unsigned int bins = mParameters.fftSize / 2 + 1;
+    Real scale = 1.0f / static_cast<Real>(mParameters.fftSize);
+
+    for (unsigned int block = 0; block < frameCount; block += BlockFrames) {
+        unsigned int count = Min(BlockFrames, frameCount - block);
+
+        for (unsigned int b = 0; b < count; ++b) {
+            unsigned int start = (firstFrame + block + b) * frameStep;
+            unsigned int available = (start < length)
+                ? Min(used, length - start) : 0;
+            const Real* samples = signal + (start - offset);
+
+            for (unsigned int i = 0; i < available; ++i)
+                mFrame[i] = samples[i];
+
+            // Pre-emphasis: y[n] = x[n] - a * x[n - 1], y[0] = x[0].
+            if (preemphasis != 0.0f) {
+                for (unsigned int i = (start == 0) ? 1 : 0; i < available; ++i)
+                    mFrame[i] -= preemphasis * samples[static_cast<int>(i) - 1];
+            }
+
+            for (unsigned int i = available; i < mParameters.fftSize; ++i)
+                mFrame[i] = 0.0f;
+
+            // Power spectra are stored transposed, one column per frame.
+            mFFT.GetPowerSpectrum(mFrame.data(), mSpectrum.data());
+
+            Accumulator energy = 0.0f;
+
+            for (unsigned int i = 0; i < bins; ++i) {
+                Real power = mSpectrum[i] * scale;
+
+                mPower[i * count + b] = power;
+                energy += power;
+            }
+
+            mFrameEnergies[b] = energy;
+        }
+
+        ComputeBlock(count, coefficients + block * mParameters.cepstrumCount);
+    }
+}
+
+void MFCC::Prepare(unsigned int sampleRate)
+{
+    unsigned int fftSize = mParameters.fftSize;
+    unsigned int filterCount = mParameters.filterCount;
+    unsigned int cepstrumCount = mParameters.cepstrumCount;
+
+    double highFrequency = (mParameters.highFrequency > 0.0f)
+        ? mParameters.highFrequency : sampleRate / 2.0;
+
+    double lowMel = HzToMel(mParameters.lowFrequency);
+    double highMel = HzToMel(highFrequency);
+
+    // Filter edges, evenly spaced on the mel scale.
+    std::vector<unsigned int> bins(filterCount + 2);
+
+    for (unsigned int i = 0; i < bins.size(); ++i) {
+        double mel = (i + 1 == bins.size()) ? highMel
+            : lowMel + i * (highMel - lowMel) / (filterCount + 1);
+        double bin = std::floor((fftSize + 1) * MelToHz(mel) / sampleRate);
+
+        bins[i] = static_cast<unsigned int>(Clamp(0.0, fftSize / 2.0, bin));
+    }
+
+    mFilterBegin.resize(filterCount);
+    mFilterOffsets.assign(1, 0);
+    mFilterWeights.clear();
+
+    for (unsigned int j = 0; j < filterCount; ++j) {
+        mFilterBegin[j] = bins[j];
+
+        for (unsigned int i = bins[j]; i < bins[j + 1]; ++i) {
+            mFilterWeights.push_back(static_cast<Real>(
+                static_cast<double>(i - bins[j]) / (bins[j + 1] - bins[j])));
+        }
+
+        for (unsigned int i = bins[j + 1]; i < bins[j + 2]; ++i) {
+            mFilterWeights.push_back(static_cast<Real>(
+                static_cast<double>(bins[j + 2] - i) / (bins[j + 2] - bins[j + 1])));
+        }
+
+        mFilterOffsets.push_back(static_cast<unsigned int>(mFilterWeights.size()));
+    }
+
+    // Orthonormal DCT-II with the lifter applied to the rows.
+    mDCT.resize(cepstrumCount * filterCount);
+
+    for (unsigned int k = 0; k < cepstrumCount; ++k) {
+        double scale = std::sqrt(((k == 0) ? 1.0 : 2.0) / filterCount);
+        double lift = 1.0;
+
+        // Integer division as in the python 2 script.
+        if (mParameters.lifter > 0) {
+            lift = 1.0 + (mParameters.lifter / 2)
+                * std::sin(Pi * k / mParameters.lifter);
+        }
+
+        for (unsigned int n = 0; n < filterCount; ++n) {
+            mDCT[k * filterCount + n] = static_cast<Real>(scale * lift
+                * std::cos(Pi * k * (2 * n + 1) / (2.0 * filterCount)));
+        }
+    }
+
+    mSampleRate = sampleRate;
+}
+
+void MFCC::ComputeBlock(unsigned int frameCount, Real* coefficients)
+{
+    unsigned int filterCount = mParameters.filterCount;
+    unsigned int cepstrumCount = mParameters.cepstrumCount;
+    Real* energies = mEnergies.data();
+
+    // Filterbank energies, each filter is a product of its non-zero
+    // weights and the power spectrum rows they cover.
+    std::fill(energies, energies + filterCount * frameCount, 0.0f);
+
+    for (unsigned int j = 0; j < filterCount; ++j) {
+        MatrixMultiplyAdd(energies + j * frameCount,
+            mFilterWeights.data() + mFilterOffsets[j],
+            mPower.data() + mFilterBegin[j] * frameCount, 1,
+            mFilterOffsets[j + 1] - mFilterOffsets[j], frameCount);
+    }
+
+    // Logarithm, zeros replaced by epsilon.
+    for (unsigned int i = 0; i < filterCount * frameCount; ++i) {
+        if (energies[i] == 0.0f)
+            energies[i] = std::numeric_limits<double>::epsilon();
+
+        energies[i] = std::log(energies[i]);
+    }
+
+    Real* cepstra = mCoefficients.data();
+
+    std::fill(cepstra, cepstra + cepstrumCount * frameCount, 0.0f);
+    MatrixMultiplyAdd(cepstra, mDCT.data(), energies, cepstrumCount,
+        filterCount, frameCount);
+
+    for (unsigned int f = 0; f < frameCount; ++f) {
+        Real* output = coefficients + f * cepstrumCount;
+
+        for (unsigned int k = 0; k < cepstrumCount; ++k)
+            output[k] = cepstra[k * frameCount + f];
+
+        if (mParameters.appendEnergy && cepstrumCount > 0) {
+            Accumulator energy = mFrameEnergies[f];
+
+            if (energy == 0.0f)
+                energy = std::numeric_limits<double>::epsilon();
+
+            output[0] = static_cast<Real>(std::log(energy));
+        }
+    }
+}
@@ -12,6 +12,11 @@
 #include "GMMRecognizer.h"
 
 #include "TestEngine.h"
+#include "FeatureExtractor.h"
+#include "FeatureFile.h"
+#include "SpeakerManifest.h"
+#include "Simd.h"
+#include "CentroidSearch.h"
 
 int main(int argc, char** argv)
 {
@@ -23,6 +28,97 @@ int main(int argc, char** argv)
 
     //std::freopen("output.txt", "w", stdout);
 
+    // Convert text sample files to binary feature files:
+    // -convert samples_1.txt samples_2.txt ...
+    if (argc >= 3 && std::string(argv[1]) == "-convert") {
+        int failed = 0;
+
+        for (int i = 2; i < argc; ++i) {
+            if (!ConvertTextSamples(argv[i], GetBinarySamplesPath(argv[i])))
+                ++failed;
+        }
+
+        return failed > 0 ? 1 : 0;
+    }
+
+    // Rebuild the speaker manifest of sample folders:
+    // -manifest folder1 folder2 ...
+    if (argc >= 3 && std::string(argv[1]) == "-manifest") {
+        int failed = 0;
+
+        for (int i = 2; i < argc; ++i) {
+            SpeakerManifest manifest;
+
+            if (!manifest.Build(argv[i])
+                || !manifest.Save(GetSpeakerManifestPath(argv[i]))) {
+                std::cout << "Could not build speaker manifest: " << argv[i]
+                    << std::endl;
+                ++failed;
+            }
+        }
+
+        return failed > 0 ? 1 : 0;
+    }
+
+    // Extract the features of a corpus to sample files:
+    // -extract corpus output [mfcc|lpc|lpcc] [deltas (0-2)] [silence removal (0/1)]
+    if (argc >= 4 && std::string(argv[1]) == "-extract") {
+        FeatureExtractor extractor;
+
+        if (argc >= 5 && std::string(argv[4]) == "lpc")
+            extractor.SetFeatureType(FeatureExtractor::FeatureType::LPC);
+        else if (argc >= 5 && std::string(argv[4]) == "lpcc")
+            extractor.SetFeatureType(FeatureExtractor::FeatureType::LPCC);
+
+        if (argc >= 6)
+            extractor.SetDeltaOrder(std::atoi(argv[5]));
+
+        if (argc >= 7)
+            extractor.SetRemoveSilence(std::atoi(argv[6]) != 0);
+
+        return extractor.ExtractCorpus(argv[2], argv[3]) ? 0 : 1;
+    }
+
+    // Check and measure the vector kernels of each instruction set:
+    // -simd [benchmark]
+    if (argc >= 2 && std::string(argv[1]) == "-simd") {
+        std::cout << "Detected: " << GetSimdLevelName(DetectSimdLevel())
+            << std::endl;
+
+        bool agree = CheckSimdKernels();
+
+        if (argc >= 3 && std::string(argv[2]) == "benchmark") {
+            BenchmarkSimdKernels();
+            BenchmarkCentroidSearch();
+        }
+
+        return agree ? 0 : 1;
+    }
+
+    // Measure the native front-ends, or compare them with reference
+    // features written by scripts/frontend_reference.py:
+    // -frontend benchmark [seconds]
+    // -frontend compare file.wav reference.txt [mfcc|lpc|lpcc]
+    if (argc >= 3 && std::string(argv[1]) == "-frontend") {
+        if (std::string(argv[2]) == "benchmark") {
+            BenchmarkFeatureExtraction(argc >= 4
+                ? static_cast<Real>(std::atof(argv[3])) : 60.0f);
+            return 0;
+        }
+
+        if (argc >= 5 && std::string(argv[2]) == "compare") {
+            FeatureExtractor::FeatureType featureType =
+                FeatureExtractor::FeatureType::MFCC;
+
+            if (argc >= 6 && std::string(argv[5]) == "lpc")
+                featureType = FeatureExtractor::FeatureType::LPC;
+            else if (argc >= 6 && std::string(argv[5]) == "lpcc")
+                featureType = FeatureExtractor::FeatureType::LPCC;
+
+            return CompareFeatures(argv[3], argv[4], featureType) ? 0 : 1;
+        }
+    }
+
     TestEngine engine;
 
     if (argc >= 2) {
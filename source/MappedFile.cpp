@@ -0,0 +1,146 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : mData(nullptr),
+    mSize(0),
+    mOpen(false)
+#ifdef _WIN32
+    , mFileHandle(INVALID_HANDLE_VALUE),
+    mMappingHandle(nullptr)
+#endif
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    mFileHandle = file;
+    mSize = static_cast<std::size_t>(size.QuadPart);
+
+    if (mSize > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY,
+            0, 0, nullptr);
+
+        if (mapping == nullptr) {
+            Close();
+            return false;
+        }
+
+        mMappingHandle = mapping;
+        mData = static_cast<const char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (mData == nullptr) {
+            Close();
+            return false;
+        }
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    mSize = static_cast<std::size_t>(st.st_size);
+
+    if (mSize > 0) {
+        void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED) {
+            close(fd);
+            mSize = 0;
+            return false;
+        }
+
+        mData = static_cast<const char*>(data);
+    }
+
+    // The mapping stays valid after closing the descriptor.
+    close(fd);
+#endif
+
+    mOpen = true;
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (mData != nullptr)
+        UnmapViewOfFile(mData);
+
+    if (mMappingHandle != nullptr)
+        CloseHandle(mMappingHandle);
+
+    if (mFileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(mFileHandle);
+
+    mMappingHandle = nullptr;
+    mFileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (mData != nullptr)
+        munmap(const_cast<char*>(mData), mSize);
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return mOpen;
+}
+
+const char* MappedFile::GetData() const
+{
+    return mData;
+}
+
+std::size_t MappedFile::GetSize() const
+{
+    return mSize;
+}
@@ -0,0 +1,120 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "MemoryPool.h"
+
+namespace
+{
+    std::size_t RoundUp(std::size_t bytes)
+    {
+        return (bytes + CacheLineSize - 1) & ~(CacheLineSize - 1);
+    }
+}
+
+void* AllocateAligned(std::size_t bytes)
+{
+    // The original pointer is stored just before the aligned memory.
+    char* memory = static_cast<char*>(
+        std::malloc(bytes + CacheLineSize + sizeof(void*)));
+
+    if (memory == nullptr)
+        return nullptr;
+
+    std::size_t address = reinterpret_cast<std::size_t>(memory + sizeof(void*));
+    char* aligned = memory + sizeof(void*)
+        + (RoundUp(address) - address);
+
+    reinterpret_cast<void**>(aligned)[-1] = memory;
+
+    return aligned;
+}
+
+void FreeAligned(void* pointer)
+{
+    if (pointer != nullptr)
+        std::free(static_cast<void**>(pointer)[-1]);
+}
+
+MemoryPool::MemoryPool(std::size_t blockSize)
+    : mBlockSize(RoundUp(Max(blockSize, CacheLineSize))),
+    mPosition(nullptr),
+    mRemaining(0),
+    mCapacity(0),
+    mAllocationCount(0)
+{
+
+}
+
+MemoryPool::~MemoryPool()
+{
+    Release();
+}
+
+void* MemoryPool::Allocate(std::size_t bytes)
+{
+    bytes = RoundUp(Max(bytes, static_cast<std::size_t>(1)));
+
+    ++mAllocationCount;
+
+    if (bytes > mBlockSize) {
+        // A block of its own, keep filling the current block afterwards.
+        void* block = AllocateAligned(bytes);
+
+        if (block == nullptr)
+            throw std::bad_alloc();
+
+        mBlocks.push_back(block);
+        mCapacity += bytes;
+
+        return block;
+    }
+
+    if (bytes > mRemaining) {
+        void* block = AllocateAligned(mBlockSize);
+
+        if (block == nullptr)
+            throw std::bad_alloc();
+
+        mBlocks.push_back(block);
+        mCapacity += mBlockSize;
+
+        mPosition = static_cast<char*>(block);
+        mRemaining = mBlockSize;
+    }
+
+    void* memory = mPosition;
+
+    mPosition += bytes;
+    mRemaining -= bytes;
+
+    return memory;
+}
+
+void MemoryPool::Release()
+{
+    for (void* block : mBlocks)
+        FreeAligned(block);
+
+    mBlocks.clear();
+
+    mPosition = nullptr;
+    mRemaining = 0;
+    mCapacity = 0;
+    mAllocationCount = 0;
+}
+
+std::size_t MemoryPool::GetAllocationCount() const
+{
+    return mAllocationCount;
+}
+
+std::size_t MemoryPool::GetBlockCount() const
+{
+    return mBlocks.size();
+}
+
+std::size_t MemoryPool::GetCapacity() const
+{
+    return mCapacity;
+}
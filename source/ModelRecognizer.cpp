@@ -158,13 +158,8 @@ void ModelRecognizer::TrainBackgroundModel()
 {
     mBackgroundModel = CreateModel();
 
-    std::vector< DynamicVector<Real> > samples;
-
-    for (const auto& speaker : mBackgroundModelData->GetSamples()) {
-        for (const auto& sample : speaker.second) {
-            samples.push_back(sample);
-        }
-    }
+    std::vector< DynamicVector<Real> > samples =
+        mBackgroundModelData->GetAllSamples();
 
     mBackgroundModel->SetOrder(GetOrder());
 
@@ -205,8 +200,7 @@ void ModelRecognizer::TrainSpeakerModels()
 
         if (adapt) {
             // UBM exists, train everything else with adaptation.
-            model->Adapt(mBackgroundModel, sequence.second,
-                mAdaptationIterations, mRelevanceFactor);
+            AdaptModel(sequence.first, model, sequence.second);
         } else {
             // No UBM, train normally.
             model->SetOrder(GetOrder());
@@ -217,6 +211,14 @@ void ModelRecognizer::TrainSpeakerModels()
     mTrainTimeSpeakerModels = timer.GetTimeElapsed();
 }
 
+void ModelRecognizer::AdaptModel(const SpeakerKey& /*speaker*/,
+    const std::shared_ptr<Model>& model,
+    const std::vector< DynamicVector<Real> >& samples)
+{
+    model->Adapt(mBackgroundModel, samples, mAdaptationIterations,
+        mRelevanceFactor);
+}
+
 void ModelRecognizer::Train()
 {
     if (mSpeakerData == nullptr || !mSpeakerData->IsConsistent()) {
@@ -291,34 +293,40 @@ void ModelRecognizer::Prepare()
 
         std::cout << "Calculating Z-norm scores." << std::endl;
 
-        for (auto& model : mSpeakerModels) {
+        std::map< SpeakerKey, std::vector<Real> > scores;
+
+        // Each impostor is scored against all the models in turn.
+        for (auto& impostor : mImpostorModels) {
             ++progress;
 
-            std::cout << "Calculating Z-norm scores: " << model.first
-                << " (" << 100 * progress / mSpeakerModels.size() << "%)" << std::endl;
+            std::cout << "Calculating Z-norm scores: " << impostor.first
+                << " (" << 100 * progress / mImpostorModels.size() << "%)" << std::endl;
 
-            std::vector<Real> scores;
+            auto it = mSpeakerData->GetSamples().find(impostor.first);
+            if (it == mSpeakerData->GetSamples().end()) {
+                std::cout << "Impostor speaker data not found." << std::endl;
+                continue;
+            }
 
-            unsigned int impostors = 0;
+            BeginScoring(it->second);
 
             // Z-norm scores.
-            for (auto& impostor : mImpostorModels) {
-                auto it = mSpeakerData->GetSamples().find(impostor.first);
-                if (it == mSpeakerData->GetSamples().end()) {
-                    std::cout << "Impostor speaker data not found." << std::endl;
-                    continue;
-                }
-                if (impostor.first != model.first) {
-                    scores.push_back(GetRatio(model.second, it->second));
-                    ++impostors;
-                }
+            for (auto& model : mSpeakerModels) {
+                if (impostor.first != model.first)
+                    scores[model.first].push_back(GetRatio(model.second, it->second));
             }
 
-            if (impostors > 1) {
+            EndScoring();
+        }
+
+        for (auto& model : mSpeakerModels) {
+            const auto& modelScores = scores[model.first];
+
+            if (modelScores.size() > 1) {
                 // Initialize speaker-specific Z-normalization parameters.
                 auto& zd = mImpostorDistributions[model.first];
-                zd.mean = Mean(scores);
-                zd.deviation = Deviation(scores, zd.mean);
+                zd.mean = Mean(modelScores);
+                zd.deviation = Deviation(modelScores, zd.mean);
             } else {
                 std::cout << "Not enough impostors for Z-normalization was found." << std::endl;
             }
@@ -387,6 +395,16 @@ Real ModelRecognizer::GetRatio(const std::shared_ptr<Model>& model, const std::v
     return model->GetScore(samples);
 }
 
+void ModelRecognizer::BeginScoring(const std::vector< DynamicVector<Real> >& /*samples*/)
+{
+
+}
+
+void ModelRecognizer::EndScoring()
+{
+
+}
+
 bool ModelRecognizer::IsRecognized(const SpeakerKey& speaker, const std::vector< DynamicVector<Real> >& samples)
 {
     Train();
@@ -428,10 +446,13 @@ Real ModelRecognizer::GetVerificationScore(const SpeakerKey& speaker, const std:
         return 0.0f;
     }
 
+    BeginScoring(samples);
+
     Real score = GetRatio(it->second, samples);
 
     // Return score immediately if normalization is not enabled.
     if (mScoreNormalizationType == ScoreNormalizationType::NONE) {
+        EndScoring();
         return score;
     }
 
@@ -468,6 +489,8 @@ Real ModelRecognizer::GetVerificationScore(const SpeakerKey& speaker, const std:
         }
     }
 
+    EndScoring();
+
     // Apply normalization.
     switch (mScoreNormalizationType) {
     case ScoreNormalizationType::ZERO:
@@ -0,0 +1,178 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "Parallel.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace
+{
+    // Output buffer of the task running on this thread.
+    thread_local std::string* tOutput = nullptr;
+
+    /*! \brief Stream buffer that redirects output of tasks to their own
+     *  buffers and forwards other output to the original buffer.
+     */
+    class TaskOutputBuffer : public std::streambuf
+    {
+    public:
+        explicit TaskOutputBuffer(std::streambuf* target)
+            : mTarget(target)
+        {
+
+        }
+
+    protected:
+        int overflow(int c) override
+        {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+                return traits_type::not_eof(c);
+
+            char value = traits_type::to_char_type(c);
+
+            return xsputn(&value, 1) == 1 ? c : traits_type::eof();
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            if (tOutput != nullptr) {
+                tOutput->append(s, static_cast<std::size_t>(n));
+                return n;
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mTarget->sputn(s, n);
+        }
+
+        int sync() override
+        {
+            if (tOutput != nullptr)
+                return 0;
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mTarget->pubsync();
+        }
+
+    private:
+        std::streambuf* mTarget;
+
+        std::mutex mMutex;
+    };
+
+    /*! \brief Installs a TaskOutputBuffer on std::cout for its lifetime.
+     *
+     *  The original buffer is restored and the task output printed in task
+     *  order on destruction, also when a task throws.
+     */
+    class TaskOutputRedirect
+    {
+    public:
+        explicit TaskOutputRedirect(std::vector<std::string>& output)
+            : mOutput(output),
+            mBuffer(std::cout.rdbuf()),
+            mPrevious(std::cout.rdbuf(&mBuffer))
+        {
+
+        }
+
+        ~TaskOutputRedirect()
+        {
+            std::cout.rdbuf(mPrevious);
+
+            for (const auto& text : mOutput)
+                std::cout << text;
+
+            std::cout.flush();
+        }
+
+        TaskOutputRedirect(const TaskOutputRedirect&) = delete;
+        TaskOutputRedirect& operator= (const TaskOutputRedirect&) = delete;
+
+    private:
+        std::vector<std::string>& mOutput;
+
+        TaskOutputBuffer mBuffer;
+
+        std::streambuf* mPrevious;
+    };
+
+    /*! \brief Directs the output of the current thread to a task buffer
+     *  for its lifetime.
+     */
+    class TaskOutputScope
+    {
+    public:
+        explicit TaskOutputScope(std::string& output)
+            : mOuter(tOutput)
+        {
+            tOutput = &output;
+        }
+
+        ~TaskOutputScope()
+        {
+            tOutput = mOuter;
+        }
+
+        TaskOutputScope(const TaskOutputScope&) = delete;
+        TaskOutputScope& operator= (const TaskOutputScope&) = delete;
+
+    private:
+        std::string* mOuter;
+    };
+}
+
+unsigned int GetThreadCount()
+{
+    return Max(std::thread::hardware_concurrency(), 1u);
+}
+
+void ParallelFor(unsigned int count,
+    const std::function<void(unsigned int)>& task, unsigned int threads)
+{
+    if (threads == 0)
+        threads = GetThreadCount();
+
+    threads = Min(threads, count);
+
+    if (threads <= 1) {
+        for (unsigned int i = 0; i < count; ++i)
+            task(i);
+
+        return;
+    }
+
+    std::atomic<unsigned int> next(0);
+
+    auto worker = [&]() {
+        unsigned int i;
+
+        while ((i = next++) < count)
+            task(i);
+    };
+
+    std::vector<std::thread> workers;
+
+    for (unsigned int t = 1; t < threads; ++t)
+        workers.emplace_back(worker);
+
+    // The calling thread works too.
+    worker();
+
+    for (auto& thread : workers)
+        thread.join();
+}
+
+void ParallelForBuffered(unsigned int count,
+    const std::function<void(unsigned int)>& task, unsigned int threads)
+{
+    std::vector<std::string> output(count);
+    TaskOutputRedirect redirect(output);
+
+    ParallelFor(count, [&](unsigned int i) {
+        TaskOutputScope scope(output[i]);
+
+        task(i);
+    }, threads);
+}
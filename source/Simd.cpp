@@ -0,0 +1,743 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "Simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SIMD_X86
+#define SIMD_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    struct Kernels
+    {
+        float (*distanceFloat)(const float*, const float*, unsigned int);
+        double (*distanceDouble)(const double*, const double*, unsigned int);
+        void (*addFloat)(float*, const float*, unsigned int);
+        void (*addDouble)(double*, const double*, unsigned int);
+        void (*subtractFloat)(float*, const float*, unsigned int);
+        void (*subtractDouble)(double*, const double*, unsigned int);
+        void (*multiplyFloat)(float*, const float*, unsigned int);
+        void (*multiplyDouble)(double*, const double*, unsigned int);
+        void (*divideFloat)(float*, const float*, unsigned int);
+        void (*divideDouble)(double*, const double*, unsigned int);
+        void (*productFloat)(float*, const float*, const float*,
+            unsigned int, unsigned int, unsigned int, unsigned int);
+        void (*productDouble)(double*, const double*, const double*,
+            unsigned int, unsigned int, unsigned int, unsigned int);
+    };
+
+    /*! \brief Matrix product c += a * b of a part of the columns.
+     *
+     *  \param stride The number of values per row in b and c.
+     */
+    template<typename T>
+    void ProductScalar(T* c, const T* a, const T* b, unsigned int rows,
+        unsigned int inner, unsigned int columns, unsigned int stride)
+    {
+        for (unsigned int r = 0; r < rows; r++) {
+            T* output = c + r * stride;
+
+            for (unsigned int i = 0; i < inner; i++) {
+                T value = a[r * inner + i];
+                const T* row = b + i * stride;
+
+                for (unsigned int k = 0; k < columns; k++)
+                    output[k] += value * row[k];
+            }
+        }
+    }
+
+#ifdef SIMD_X86
+    // Element-wise operations: full vectors, then the remaining values.
+#define SIMD_ELEMENTWISE(isa, name, T, width, load, store, op, scalarOp) \
+    SIMD_TARGET(isa) void name(T* a, const T* b, unsigned int size) \
+    { \
+        unsigned int i = 0; \
+        for (; i + width <= size; i += width) \
+            store(a + i, op(load(a + i), load(b + i))); \
+        for (; i < size; i++) \
+            a[i] scalarOp b[i]; \
+    }
+
+    // Element-wise operations: full vectors, then the rest with a narrower
+    // kernel. Masked stores are not forwarded to the masked loads of the
+    // next call, which stalls in-place accumulation.
+#define SIMD_ELEMENTWISE_WIDE(isa, name, T, width, load, store, op, rest) \
+    SIMD_TARGET(isa) void name(T* a, const T* b, unsigned int size) \
+    { \
+        unsigned int i = 0; \
+        for (; i + width <= size; i += width) \
+            store(a + i, op(load(a + i), load(b + i))); \
+        if (i < size) \
+            rest(a + i, b + i, size - i); \
+    }
+
+    // SSE2
+
+    SIMD_TARGET("sse2") float DistanceSse2(const float* a, const float* b,
+        unsigned int size)
+    {
+        __m128 sum = _mm_setzero_ps();
+        unsigned int i = 0;
+
+        for (; i + 4 <= size; i += 4) {
+            __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+            sum = _mm_add_ps(sum, _mm_mul_ps(diff, diff));
+        }
+
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+
+        float distance = _mm_cvtss_f32(sum);
+
+        for (; i < size; i++) {
+            float diff = a[i] - b[i];
+            distance += diff * diff;
+        }
+
+        return distance;
+    }
+
+    SIMD_TARGET("sse2") double DistanceSse2(const double* a, const double* b,
+        unsigned int size)
+    {
+        __m128d sum = _mm_setzero_pd();
+        unsigned int i = 0;
+
+        for (; i + 2 <= size; i += 2) {
+            __m128d diff = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+            sum = _mm_add_pd(sum, _mm_mul_pd(diff, diff));
+        }
+
+        double distance = _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+
+        for (; i < size; i++) {
+            double diff = a[i] - b[i];
+            distance += diff * diff;
+        }
+
+        return distance;
+    }
+
+    // Matrix product c += a * b: two vectors of columns for four rows at a
+    // time kept in registers over the inner loop. The rest of the columns
+    // with a narrower kernel.
+#define SIMD_MATRIX_PRODUCT(isa, name, T, V, width, load, store, set1, multiplyAdd, rest) \
+    SIMD_TARGET(isa) void name(T* c, const T* a, const T* b, unsigned int rows, \
+        unsigned int inner, unsigned int columns, unsigned int stride) \
+    { \
+        unsigned int k = 0; \
+        for (; k + 2 * width <= columns; k += 2 * width) { \
+            unsigned int r = 0; \
+            for (; r + 4 <= rows; r += 4) { \
+                T* c0 = c + r * stride + k; \
+                T* c1 = c0 + stride; \
+                T* c2 = c1 + stride; \
+                T* c3 = c2 + stride; \
+                const T* a0 = a + r * inner; \
+                V s00 = load(c0), s01 = load(c0 + width); \
+                V s10 = load(c1), s11 = load(c1 + width); \
+                V s20 = load(c2), s21 = load(c2 + width); \
+                V s30 = load(c3), s31 = load(c3 + width); \
+                for (unsigned int i = 0; i < inner; i++) { \
+                    const T* row = b + i * stride + k; \
+                    V b0 = load(row), b1 = load(row + width); \
+                    V x = set1(a0[i]); \
+                    s00 = multiplyAdd(x, b0, s00); \
+                    s01 = multiplyAdd(x, b1, s01); \
+                    x = set1(a0[inner + i]); \
+                    s10 = multiplyAdd(x, b0, s10); \
+                    s11 = multiplyAdd(x, b1, s11); \
+                    x = set1(a0[2 * inner + i]); \
+                    s20 = multiplyAdd(x, b0, s20); \
+                    s21 = multiplyAdd(x, b1, s21); \
+                    x = set1(a0[3 * inner + i]); \
+                    s30 = multiplyAdd(x, b0, s30); \
+                    s31 = multiplyAdd(x, b1, s31); \
+                } \
+                store(c0, s00); store(c0 + width, s01); \
+                store(c1, s10); store(c1 + width, s11); \
+                store(c2, s20); store(c2 + width, s21); \
+                store(c3, s30); store(c3 + width, s31); \
+            } \
+            for (; r < rows; r++) { \
+                T* c0 = c + r * stride + k; \
+                const T* a0 = a + r * inner; \
+                V s00 = load(c0), s01 = load(c0 + width); \
+                for (unsigned int i = 0; i < inner; i++) { \
+                    const T* row = b + i * stride + k; \
+                    V x = set1(a0[i]); \
+                    s00 = multiplyAdd(x, load(row), s00); \
+                    s01 = multiplyAdd(x, load(row + width), s01); \
+                } \
+                store(c0, s00); store(c0 + width, s01); \
+            } \
+        } \
+        if (k < columns) \
+            rest(c + k, a, b + k, rows, inner, columns - k, stride); \
+    }
+
+    SIMD_TARGET("sse2") __m128 MultiplyAddSse2(__m128 a, __m128 b, __m128 c)
+    {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+    SIMD_TARGET("sse2") __m128d MultiplyAddSse2(__m128d a, __m128d b, __m128d c)
+    {
+        return _mm_add_pd(_mm_mul_pd(a, b), c);
+    }
+
+    SIMD_ELEMENTWISE("sse2", AddSse2, float, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_add_ps, +=)
+    SIMD_ELEMENTWISE("sse2", AddSse2, double, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd, +=)
+    SIMD_ELEMENTWISE("sse2", SubtractSse2, float, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_sub_ps, -=)
+    SIMD_ELEMENTWISE("sse2", SubtractSse2, double, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_sub_pd, -=)
+    SIMD_ELEMENTWISE("sse2", MultiplySse2, float, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_mul_ps, *=)
+    SIMD_ELEMENTWISE("sse2", MultiplySse2, double, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_mul_pd, *=)
+    SIMD_ELEMENTWISE("sse2", DivideSse2, float, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_div_ps, /=)
+    SIMD_ELEMENTWISE("sse2", DivideSse2, double, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_div_pd, /=)
+    SIMD_MATRIX_PRODUCT("sse2", ProductSse2, float, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, MultiplyAddSse2, ProductScalar<float>)
+    SIMD_MATRIX_PRODUCT("sse2", ProductSse2, double, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, MultiplyAddSse2, ProductScalar<double>)
+
+    // AVX2
+
+    SIMD_TARGET("avx2,fma") float DistanceAvx2(const float* a, const float* b,
+        unsigned int size)
+    {
+        __m256 sum = _mm256_setzero_ps();
+        unsigned int i = 0;
+
+        for (; i + 8 <= size; i += 8) {
+            __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+            sum = _mm256_fmadd_ps(diff, diff, sum);
+        }
+
+        // A half vector of the rest.
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum),
+            _mm256_extractf128_ps(sum, 1));
+
+        if (i + 4 <= size) {
+            __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+            half = _mm_fmadd_ps(diff, diff, half);
+            i += 4;
+        }
+
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_movehdup_ps(half));
+
+        float distance = _mm_cvtss_f32(half);
+
+        for (; i < size; i++) {
+            float diff = a[i] - b[i];
+            distance += diff * diff;
+        }
+
+        return distance;
+    }
+
+    SIMD_TARGET("avx2,fma") double DistanceAvx2(const double* a,
+        const double* b, unsigned int size)
+    {
+        __m256d sum = _mm256_setzero_pd();
+        unsigned int i = 0;
+
+        for (; i + 4 <= size; i += 4) {
+            __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+            sum = _mm256_fmadd_pd(diff, diff, sum);
+        }
+
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum),
+            _mm256_extractf128_pd(sum, 1));
+
+        if (i + 2 <= size) {
+            __m128d diff = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+            half = _mm_fmadd_pd(diff, diff, half);
+            i += 2;
+        }
+
+        double distance = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+
+        for (; i < size; i++) {
+            double diff = a[i] - b[i];
+            distance += diff * diff;
+        }
+
+        return distance;
+    }
+
+    SIMD_ELEMENTWISE("avx2", AddAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, +=)
+    SIMD_ELEMENTWISE("avx2", AddAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, +=)
+    SIMD_ELEMENTWISE("avx2", SubtractAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_sub_ps, -=)
+    SIMD_ELEMENTWISE("avx2", SubtractAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_sub_pd, -=)
+    SIMD_ELEMENTWISE("avx2", MultiplyAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_mul_ps, *=)
+    SIMD_ELEMENTWISE("avx2", MultiplyAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_mul_pd, *=)
+    SIMD_ELEMENTWISE("avx2", DivideAvx2, float, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_div_ps, /=)
+    SIMD_ELEMENTWISE("avx2", DivideAvx2, double, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_div_pd, /=)
+    SIMD_MATRIX_PRODUCT("avx2,fma", ProductAvx2, float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_fmadd_ps, ProductSse2)
+    SIMD_MATRIX_PRODUCT("avx2,fma", ProductAvx2, double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_fmadd_pd, ProductSse2)
+
+    // AVX-512, the distance tail is handled with a masked vector.
+
+    SIMD_TARGET("avx512f") float Sum(__m512 vector)
+    {
+        __m128 sum = _mm_add_ps(
+            _mm_add_ps(_mm512_maskz_extractf32x4_ps(0xF, vector, 0), _mm512_maskz_extractf32x4_ps(0xF, vector, 1)),
+            _mm_add_ps(_mm512_maskz_extractf32x4_ps(0xF, vector, 2), _mm512_maskz_extractf32x4_ps(0xF, vector, 3)));
+
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+
+        return _mm_cvtss_f32(sum);
+    }
+
+    SIMD_TARGET("avx512f") double Sum(__m512d vector)
+    {
+        __m256d quarter = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xF, vector, 0),
+            _mm512_maskz_extractf64x4_pd(0xF, vector, 1));
+        __m128d sum = _mm_add_pd(_mm256_extractf128_pd(quarter, 0),
+            _mm256_extractf128_pd(quarter, 1));
+
+        return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    }
+
+    SIMD_TARGET("avx512f") float DistanceAvx512(const float* a, const float* b,
+        unsigned int size)
+    {
+        __m512 sum = _mm512_setzero_ps();
+
+        for (unsigned int i = 0; i < size; i += 16) {
+            __mmask16 mask = (size - i >= 16) ? static_cast<__mmask16>(0xFFFF)
+                : static_cast<__mmask16>((1u << (size - i)) - 1);
+            __m512 diff = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                _mm512_maskz_loadu_ps(mask, b + i));
+            sum = _mm512_fmadd_ps(diff, diff, sum);
+        }
+
+        return Sum(sum);
+    }
+
+    SIMD_TARGET("avx512f") double DistanceAvx512(const double* a,
+        const double* b, unsigned int size)
+    {
+        __m512d sum = _mm512_setzero_pd();
+
+        for (unsigned int i = 0; i < size; i += 8) {
+            __mmask8 mask = (size - i >= 8) ? static_cast<__mmask8>(0xFF)
+                : static_cast<__mmask8>((1u << (size - i)) - 1);
+            __m512d diff = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + i),
+                _mm512_maskz_loadu_pd(mask, b + i));
+            sum = _mm512_fmadd_pd(diff, diff, sum);
+        }
+
+        return Sum(sum);
+    }
+
+    SIMD_ELEMENTWISE_WIDE("avx512f", AddAvx512, float, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, AddAvx2)
+    SIMD_ELEMENTWISE_WIDE("avx512f", AddAvx512, double, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, AddAvx2)
+    SIMD_ELEMENTWISE_WIDE("avx512f", SubtractAvx512, float, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_sub_ps, SubtractAvx2)
+    SIMD_ELEMENTWISE_WIDE("avx512f", SubtractAvx512, double, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_sub_pd, SubtractAvx2)
+    SIMD_ELEMENTWISE_WIDE("avx512f", MultiplyAvx512, float, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_mul_ps, MultiplyAvx2)
+    SIMD_ELEMENTWISE_WIDE("avx512f", MultiplyAvx512, double, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_mul_pd, MultiplyAvx2)
+    SIMD_ELEMENTWISE_WIDE("avx512f", DivideAvx512, float, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_div_ps, DivideAvx2)
+    SIMD_ELEMENTWISE_WIDE("avx512f", DivideAvx512, double, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_div_pd, DivideAvx2)
+    SIMD_MATRIX_PRODUCT("avx512f", ProductAvx512, float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_fmadd_ps, ProductAvx2)
+    SIMD_MATRIX_PRODUCT("avx512f", ProductAvx512, double, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_fmadd_pd, ProductAvx2)
+
+#undef SIMD_ELEMENTWISE
+#undef SIMD_ELEMENTWISE_WIDE
+#undef SIMD_MATRIX_PRODUCT
+#endif
+
+    Kernels GetKernels(SimdLevel level)
+    {
+        Kernels kernels = {
+            &VectorDistance<float>, &VectorDistance<double>,
+            &VectorAdd<float>, &VectorAdd<double>,
+            &VectorSubtract<float>, &VectorSubtract<double>,
+            &VectorMultiply<float>, &VectorMultiply<double>,
+            &VectorDivide<float>, &VectorDivide<double>,
+            &ProductScalar<float>, &ProductScalar<double>
+        };
+
+#ifdef SIMD_X86
+        switch (level) {
+        case SimdLevel::SSE2:
+            kernels = {
+                &DistanceSse2, &DistanceSse2, &AddSse2, &AddSse2,
+                &SubtractSse2, &SubtractSse2, &MultiplySse2, &MultiplySse2,
+                &DivideSse2, &DivideSse2, &ProductSse2, &ProductSse2
+            };
+            break;
+        case SimdLevel::AVX2:
+            kernels = {
+                &DistanceAvx2, &DistanceAvx2, &AddAvx2, &AddAvx2,
+                &SubtractAvx2, &SubtractAvx2, &MultiplyAvx2, &MultiplyAvx2,
+                &DivideAvx2, &DivideAvx2, &ProductAvx2, &ProductAvx2
+            };
+            break;
+        case SimdLevel::AVX512:
+            kernels = {
+                &DistanceAvx512, &DistanceAvx512, &AddAvx512, &AddAvx512,
+                &SubtractAvx512, &SubtractAvx512, &MultiplyAvx512, &MultiplyAvx512,
+                &DivideAvx512, &DivideAvx512, &ProductAvx512, &ProductAvx512
+            };
+            break;
+        default:
+            break;
+        }
+#endif
+
+        return kernels;
+    }
+
+    SimdLevel gSimdLevel = DetectSimdLevel();
+
+    Kernels gKernels = GetKernels(gSimdLevel);
+}
+
+SimdLevel DetectSimdLevel()
+{
+#if defined(SIMD_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        return SimdLevel::AVX512;
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SimdLevel::AVX2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::SSE2;
+#elif defined(SIMD_X86)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+
+    // The operating system must save the AVX (and AVX-512) registers.
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool avxState = (xcr0 & 0x6) == 0x6;
+    bool avx512State = (xcr0 & 0xE6) == 0xE6;
+
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+
+        if (avx512State && (info[1] & (1 << 16)) != 0)
+            return SimdLevel::AVX512;
+
+        if (avxState && fma && (info[1] & (1 << 5)) != 0)
+            return SimdLevel::AVX2;
+    }
+
+    if (sse2)
+        return SimdLevel::SSE2;
+#endif
+
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel GetSimdLevel()
+{
+    return gSimdLevel;
+}
+
+SimdLevel SetSimdLevel(SimdLevel level)
+{
+    gSimdLevel = Min(level, DetectSimdLevel());
+    gKernels = GetKernels(gSimdLevel);
+
+    return gSimdLevel;
+}
+
+std::string GetSimdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+float VectorDistance(const float* a, const float* b, unsigned int size)
+{
+    return gKernels.distanceFloat(a, b, size);
+}
+
+double VectorDistance(const double* a, const double* b, unsigned int size)
+{
+    return gKernels.distanceDouble(a, b, size);
+}
+
+void VectorAdd(float* a, const float* b, unsigned int size)
+{
+    gKernels.addFloat(a, b, size);
+}
+
+void VectorAdd(double* a, const double* b, unsigned int size)
+{
+    gKernels.addDouble(a, b, size);
+}
+
+void VectorSubtract(float* a, const float* b, unsigned int size)
+{
+    gKernels.subtractFloat(a, b, size);
+}
+
+void VectorSubtract(double* a, const double* b, unsigned int size)
+{
+    gKernels.subtractDouble(a, b, size);
+}
+
+void VectorMultiply(float* a, const float* b, unsigned int size)
+{
+    gKernels.multiplyFloat(a, b, size);
+}
+
+void VectorMultiply(double* a, const double* b, unsigned int size)
+{
+    gKernels.multiplyDouble(a, b, size);
+}
+
+void VectorDivide(float* a, const float* b, unsigned int size)
+{
+    gKernels.divideFloat(a, b, size);
+}
+
+void VectorDivide(double* a, const double* b, unsigned int size)
+{
+    gKernels.divideDouble(a, b, size);
+}
+
+void MatrixMultiplyAdd(float* c, const float* a, const float* b,
+    unsigned int rows, unsigned int inner, unsigned int columns)
+{
+    gKernels.productFloat(c, a, b, rows, inner, columns, columns);
+}
+
+void MatrixMultiplyAdd(double* c, const double* a, const double* b,
+    unsigned int rows, unsigned int inner, unsigned int columns)
+{
+    gKernels.productDouble(c, a, b, rows, inner, columns, columns);
+}
+
+namespace
+{
+    /*! \brief Compares the kernels of the active level to the scalar ones.
+     *
+     *  \param size The vector size.
+     *  \param tolerance Allowed relative difference of the distances.
+     *
+     *  \return The number of mismatches.
+     */
+    template<typename T>
+    unsigned int CheckKernels(unsigned int size, double tolerance)
+    {
+        std::mt19937 generator(size);
+        std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+        std::vector<T> a(size), b(size);
+
+        for (unsigned int i = 0; i < size; i++) {
+            a[i] = static_cast<T>(distribution(generator));
+            b[i] = static_cast<T>(distribution(generator));
+
+            // Divisors away from zero, one exact zero to check the tail.
+            if (i == size / 2)
+                b[i] = T();
+            else if (std::abs(b[i]) < T(0.5))
+                b[i] += T(1);
+        }
+
+        unsigned int mismatches = 0;
+
+        T expected = VectorDistance<T>(a.data(), b.data(), size);
+        T actual = VectorDistance(a.data(), b.data(), size);
+
+        if (std::abs(actual - expected) > tolerance * std::abs(expected))
+            ++mismatches;
+
+        void (*scalar[])(T*, const T*, unsigned int) = {
+            &VectorAdd<T>, &VectorSubtract<T>, &VectorMultiply<T>, &VectorDivide<T>
+        };
+        void (*vector[])(T*, const T*, unsigned int) = {
+            &VectorAdd, &VectorSubtract, &VectorMultiply, &VectorDivide
+        };
+
+        // Value by value operations are exact.
+        for (unsigned int op = 0; op < 4; op++) {
+            std::vector<T> x = a, y = a;
+
+            scalar[op](x.data(), b.data(), size);
+            vector[op](y.data(), b.data(), size);
+
+            if (x != y)
+                ++mismatches;
+        }
+
+        // Matrix product of a few rows, size columns.
+        unsigned int rows = size % 9 + 1;
+        unsigned int inner = size % 40 + 1;
+        std::vector<T> x(rows * inner), y(inner * size), c(rows * size);
+
+        for (auto& value : x)
+            value = static_cast<T>(distribution(generator));
+
+        for (auto& value : y)
+            value = static_cast<T>(distribution(generator));
+
+        for (auto& value : c)
+            value = static_cast<T>(distribution(generator));
+
+        std::vector<T> product = c;
+
+        MatrixMultiplyAdd<T>(c.data(), x.data(), y.data(), rows, inner, size);
+        MatrixMultiplyAdd(product.data(), x.data(), y.data(), rows, inner, size);
+
+        // Relative to the largest possible sum (values up to 10).
+        for (unsigned int i = 0; i < c.size(); i++) {
+            if (std::abs(product[i] - c[i]) > tolerance * 100.0 * (inner + 1))
+                ++mismatches;
+        }
+
+        return mismatches;
+    }
+
+    /*! \brief Measures the kernels of the active level.
+     *
+     *  \param size The vector size.
+     */
+    template<typename T>
+    void BenchmarkKernels(unsigned int size)
+    {
+        const unsigned int calls = 1000000;
+        std::vector<T> a(size, T(1.5)), b(size, T(1.0000001));
+        volatile T sink = T();
+
+        void (*ops[])(T*, const T*, unsigned int) = {
+            &VectorAdd, &VectorSubtract, &VectorMultiply, &VectorDivide
+        };
+
+        std::cout << "  " << size << ":";
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int i = 0; i < calls; i++)
+            sink = sink + VectorDistance(a.data(), b.data(), size);
+
+        std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+        std::cout << " " << elapsed.count() * 1e9 / calls;
+
+        for (unsigned int op = 0; op < 4; op++) {
+            start = std::chrono::high_resolution_clock::now();
+
+            for (unsigned int i = 0; i < calls; i++)
+                ops[op](a.data(), b.data(), size);
+
+            elapsed = std::chrono::high_resolution_clock::now() - start;
+            std::cout << " " << elapsed.count() * 1e9 / calls;
+        }
+
+        std::cout << std::endl;
+    }
+
+    /*! \brief Measures the matrix product of the active level.
+     *
+     *  \param rows The number of rows (e.g. frames).
+     *  \param inner The inner size (e.g. dimensions).
+     *  \param columns The number of columns (e.g. mixture components).
+     */
+    template<typename T>
+    void BenchmarkProduct(unsigned int rows, unsigned int inner,
+        unsigned int columns)
+    {
+        const unsigned int calls = 200;
+        std::vector<T> a(rows * inner, T(0.5)), b(inner * columns, T(0.25));
+        std::vector<T> c(rows * columns);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (unsigned int i = 0; i < calls; i++)
+            MatrixMultiplyAdd(c.data(), a.data(), b.data(), rows, inner, columns);
+
+        std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+
+        std::cout << "  " << rows << "x" << inner << "x" << columns << ": "
+            << 2.0 * rows * inner * columns * calls / elapsed.count() * 1e-9
+            << " GFLOP/s" << std::endl;
+    }
+}
+
+bool CheckSimdKernels()
+{
+    SimdLevel original = GetSimdLevel();
+    unsigned int failed = 0;
+
+    for (int level = 0; level <= static_cast<int>(DetectSimdLevel()); level++) {
+        SetSimdLevel(static_cast<SimdLevel>(level));
+
+        unsigned int mismatches = 0;
+
+        for (unsigned int size = 1; size <= 80; size++) {
+            mismatches += CheckKernels<float>(size, 1e-5);
+            mismatches += CheckKernels<double>(size, 1e-12);
+        }
+
+        std::cout << GetSimdLevelName(GetSimdLevel()) << ": "
+            << (mismatches == 0 ? "ok" : toString(mismatches) + " mismatches")
+            << std::endl;
+
+        failed += mismatches;
+    }
+
+    SetSimdLevel(original);
+
+    return failed == 0;
+}
+
+void BenchmarkSimdKernels()
+{
+    SimdLevel original = GetSimdLevel();
+    const unsigned int sizes[] = { 13, 26, 39 };
+
+    for (int level = 0; level <= static_cast<int>(DetectSimdLevel()); level++) {
+        SetSimdLevel(static_cast<SimdLevel>(level));
+
+        std::cout << GetSimdLevelName(GetSimdLevel())
+            << " (ns per call: distance add subtract multiply divide)" << std::endl;
+
+        std::cout << " float" << std::endl;
+
+        for (unsigned int size : sizes)
+            BenchmarkKernels<float>(size);
+
+        std::cout << " double" << std::endl;
+
+        for (unsigned int size : sizes)
+            BenchmarkKernels<double>(size);
+
+        std::cout << " matrix product (float, double)" << std::endl;
+
+        BenchmarkProduct<float>(64, 39, 256);
+        BenchmarkProduct<double>(64, 39, 256);
+    }
+
+    SetSimdLevel(original);
+}
@@ -0,0 +1,86 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "SlidingCMVN.h"
+
+SlidingCMVN::SlidingCMVN(unsigned int dimensionCount, unsigned int windowSize)
+{
+    Reset(dimensionCount, windowSize);
+}
+
+SlidingCMVN::~SlidingCMVN()
+{
+
+}
+
+void SlidingCMVN::Reset(unsigned int dimensionCount, unsigned int windowSize)
+{
+    if (windowSize == 0)
+        windowSize = 1;
+
+    mDimensionCount = dimensionCount;
+    mWindowSize = windowSize;
+    mCount = 0;
+    mPosition = 0;
+
+    mWindow.assign(dimensionCount * windowSize, 0.0f);
+    mSums.assign(dimensionCount, 0.0f);
+    mSquares.assign(dimensionCount, 0.0f);
+}
+
+void SlidingCMVN::Normalize(Real* frame)
+{
+    Real* slot = mWindow.data() + mPosition * mDimensionCount;
+    Accumulator* sums = mSums.data();
+    Accumulator* squares = mSquares.data();
+
+    // Remove the oldest frame.
+    if (mCount == mWindowSize) {
+        for (unsigned int d = 0; d < mDimensionCount; ++d) {
+            sums[d] -= slot[d];
+            squares[d] -= static_cast<Accumulator>(slot[d]) * slot[d];
+        }
+    } else {
+        ++mCount;
+    }
+
+    for (unsigned int d = 0; d < mDimensionCount; ++d) {
+        slot[d] = frame[d];
+        sums[d] += frame[d];
+        squares[d] += static_cast<Accumulator>(frame[d]) * frame[d];
+    }
+
+    mPosition = (mPosition + 1) % mWindowSize;
+
+    Accumulator invCount = 1.0f / static_cast<Accumulator>(mCount);
+    Accumulator invCount1 = (mCount > 1)
+        ? 1.0f / static_cast<Accumulator>(mCount - 1) : 0.0f;
+
+    for (unsigned int d = 0; d < mDimensionCount; ++d) {
+        Accumulator mean = sums[d] * invCount;
+        Accumulator variance = (squares[d] - sums[d] * mean) * invCount1;
+
+        // Constant values (or a single frame), mean normalization only.
+        // The running sums leave rounding errors relative to mean(x^2).
+        if (variance > std::numeric_limits<Real>::epsilon() * squares[d] * invCount)
+            frame[d] = static_cast<Real>((frame[d] - mean) / std::sqrt(variance));
+        else
+            frame[d] = static_cast<Real>(frame[d] - mean);
+    }
+}
+
+void SlidingCMVN::Normalize(DynamicVector<Real>& frame)
+{
+    Normalize(frame.GetData());
+}
+
+unsigned int SlidingCMVN::GetDimensionCount() const
+{
+    return mDimensionCount;
+}
+
+unsigned int SlidingCMVN::GetWindowSize() const
+{
+    return mWindowSize;
+}
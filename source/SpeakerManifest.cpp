@@ -0,0 +1,208 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "SpeakerManifest.h"
+
+#include "FeatureParser.h"
+#include "Parallel.h"
+
+#include <mutex>
+
+namespace
+{
+    /*! \brief Scans a sample file.
+     *
+     *  \param path Path to the sample file.
+     *  \param entry Entry to be filled (id, frame count, byte size).
+     *
+     *  \return True if the file has speaker data, false otherwise.
+     */
+    bool ScanSamples(const std::string& path, SpeakerManifest::Entry& entry)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+        if (!file.good())
+            return false;
+
+        entry.byteSize = static_cast<uint64_t>(file.tellg());
+        entry.frameCount = 0;
+
+        file.seekg(0);
+
+        FeatureParser parser;
+        std::string line;
+
+        while (std::getline(file, line)) {
+            if (entry.id.empty()) {
+                if (line.size() < 3) {
+                    std::cout << "Scanning failed: insufficient data." << std::endl;
+                    return false;
+                }
+
+                entry.id = line.substr(0, 3);
+            }
+
+            if (parser.Parse(line))
+                entry.frameCount += parser.GetFrameCount();
+        }
+
+        return !entry.id.empty();
+    }
+}
+
+std::string GetSpeakerManifestPath(const std::string& folder)
+{
+    return folder + "/speakers.txt";
+}
+
+SpeakerManifest::SpeakerManifest()
+{
+
+}
+
+SpeakerManifest::~SpeakerManifest()
+{
+
+}
+
+bool SpeakerManifest::Load(const std::string& path)
+{
+    std::ifstream file(path);
+
+    if (!file.good())
+        return false;
+
+    mEntries.clear();
+
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::stringstream ss(line);
+        Entry entry;
+
+        if (!(ss >> entry.number >> entry.id >> entry.file
+            >> entry.frameCount >> entry.byteSize)) {
+            std::cout << "Invalid speaker manifest '" << path << "'." << std::endl;
+            mEntries.clear();
+            return false;
+        }
+
+        mEntries.push_back(entry);
+    }
+
+    return true;
+}
+
+bool SpeakerManifest::Save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::trunc);
+
+    file << "# number id file frames bytes" << std::endl;
+
+    for (const auto& entry : mEntries) {
+        file << entry.number << " " << entry.id << " " << entry.file << " "
+            << entry.frameCount << " " << entry.byteSize << std::endl;
+    }
+
+    return file.good();
+}
+
+bool SpeakerManifest::Build(const std::string& folder)
+{
+    mEntries.clear();
+
+    // Probe the file numbers first, then scan the files concurrently.
+    std::vector<unsigned int> numbers;
+
+    for (unsigned int n = 1; ; ++n) {
+        if (FileExists(folder + "/samples_" + toString(n) + ".txt"))
+            numbers.push_back(n);
+        else if (n >= 109)
+            break;
+    }
+
+    std::vector<Entry> entries(numbers.size());
+    std::vector<char> valid(numbers.size(), 0);
+
+    ParallelFor(static_cast<unsigned int>(numbers.size()), [&](unsigned int i) {
+        entries[i].number = numbers[i];
+        entries[i].file = "samples_" + toString(numbers[i]) + ".txt";
+        valid[i] = ScanSamples(folder + "/" + entries[i].file, entries[i]);
+    });
+
+    for (unsigned int i = 0; i < entries.size(); ++i) {
+        if (valid[i]) {
+            mEntries.push_back(entries[i]);
+
+            std::cout << "Scanned: " << entries[i].number << ":"
+                << entries[i].id << std::endl;
+        }
+    }
+
+    return !mEntries.empty();
+}
+
+bool SpeakerManifest::IsCurrent(const std::string& folder) const
+{
+    uint64_t size;
+    int64_t time;
+
+    for (const auto& entry : mEntries) {
+        if (!GetFileStatus(folder + "/" + entry.file, size, time)
+            || size != entry.byteSize)
+            return false;
+    }
+
+    // A new speaker appended after the last one.
+    unsigned int last = mEntries.empty() ? 0 : mEntries.back().number;
+
+    return !GetFileStatus(folder + "/samples_" + toString(last + 1) + ".txt",
+        size, time) || size == 0;
+}
+
+unsigned int SpeakerManifest::GetSpeakerCount() const
+{
+    return static_cast<unsigned int>(mEntries.size());
+}
+
+const SpeakerManifest::Entry* SpeakerManifest::GetEntry(unsigned int index) const
+{
+    if (index == 0 || index > mEntries.size())
+        return nullptr;
+
+    return &mEntries[index - 1];
+}
+
+std::shared_ptr<const SpeakerManifest> SpeakerManifest::Get(
+    const std::string& folder)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const SpeakerManifest> > manifests;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& manifest = manifests[folder];
+
+    if (manifest == nullptr) {
+        auto loaded = std::make_shared<SpeakerManifest>();
+        std::string path = GetSpeakerManifestPath(folder);
+
+        if (!loaded->Load(path) || !loaded->IsCurrent(folder)) {
+            std::cout << "Building speaker manifest: " << path << std::endl;
+
+            if (loaded->Build(folder) && !loaded->Save(path)) {
+                // The manifest is still usable in memory.
+                std::cout << "Could not save speaker manifest '" << path
+                    << "'." << std::endl;
+            }
+        }
+
+        manifest = loaded;
+    }
+
+    return manifest;
+}
@@ -4,12 +4,103 @@
 
 #include "SpeechData.h"
 
+#include "Deltas.h"
+#include "FeatureFile.h"
+#include "FeatureParser.h"
+#include "FeatureStatistics.h"
+#include "LineIndex.h"
+#include "Parallel.h"
+#include "SlidingCMVN.h"
+#include "SpeakerManifest.h"
+#include "Timer.h"
+#include "VoiceActivityDetector.h"
+
+namespace
+{
+    /*! \brief Resolves the final label of a loaded utterance.
+     *
+     *  \param label The label read from the sample file.
+     *  \param utterance Index of the utterance from the start line.
+     *  \param progress Loading progress in percents.
+     *
+     *  \see SpeechData::Load()
+     */
+    std::string GetUtteranceLabel(const std::string& label,
+        unsigned int utterance, unsigned int multiplier, bool train,
+        const std::string& alias, unsigned int progress)
+    {
+        std::string result = label;
+
+        if (alias.size() >= 3) {
+            result[0] = alias[0];
+            result[1] = alias[1];
+            result[2] = alias[2];
+        }
+
+        if (train || multiplier > 1) {
+            result.erase(3);
+        }
+
+        if (!train && multiplier > 1) {
+            std::stringstream ss;
+            ss << result << "_" << (utterance / multiplier) + 1;
+            result = ss.str();
+
+            std::cout << "Loading samples from '" << label << "' to '"
+                << result << "'" << " mul " << multiplier
+                << " (" << progress << "%)" << std::endl;
+        } else {
+            std::cout << "Loading samples from '" << label << "' to '"
+                << result << "'"
+                << " (" << progress << "%)" << std::endl;
+        }
+
+        return result;
+    }
+}
+
 SpeechData::SpeechData()
     : mNormalizationType(FeatureNormalizationType::CEPSTRAL_MEAN_VARIANCE),
+    mNormalizationWindow(SlidingCMVN::DefaultWindowSize),
+    mComputeDeltas(false),
+    mRemoveSilence(false),
+    mFrames(std::make_shared<FeatureMatrix>()),
+    mSampleDimensionCount(0),
+    mFrameSizeMismatch(false),
     mConsistent(true),
-    mDimensionCount(0)
+    mDimensionCount(0),
+    mTotalSampleCount(0)
+{
+
+}
+
+SpeechData::SpeechData(const SpeechData& other)
+    : mNormalizationType(other.mNormalizationType),
+    mNormalizationWindow(other.mNormalizationWindow),
+    mComputeDeltas(other.mComputeDeltas),
+    mRemoveSilence(other.mRemoveSilence),
+    mFrames(other.mFrames),
+    mUtterances(other.mUtterances),
+    mSampleDimensionCount(other.mSampleDimensionCount),
+    mFrameSizeMismatch(other.mFrameSizeMismatch),
+    mConsistent(other.mConsistent),
+    mDimensionCount(other.mDimensionCount),
+    mTotalSampleCount(other.mTotalSampleCount)
 {
+    UpdateSamples();
+}
+
+SpeechData::SpeechData(const SpeechData& other, unsigned int dimensionCount)
+    : SpeechData(other)
+{
+    if (dimensionCount < mFrames->GetColumnCount()) {
+        mSampleDimensionCount = dimensionCount;
+
+        if (mDimensionCount > dimensionCount)
+            mDimensionCount = dimensionCount;
 
+        UpdateSamples();
+    }
 }
 
 SpeechData::~SpeechData()
@@ -17,6 +108,27 @@ SpeechData::~SpeechData()
 
 }
 
+SpeechData& SpeechData::operator= (const SpeechData& other)
+{
+    if (&other != this) {
+        mNormalizationType = other.mNormalizationType;
+        mNormalizationWindow = other.mNormalizationWindow;
+        mComputeDeltas = other.mComputeDeltas;
+        mRemoveSilence = other.mRemoveSilence;
+        mFrames = other.mFrames;
+        mUtterances = other.mUtterances;
+        mSampleDimensionCount = other.mSampleDimensionCount;
+        mFrameSizeMismatch = other.mFrameSizeMismatch;
+        mConsistent = other.mConsistent;
+        mDimensionCount = other.mDimensionCount;
+        mTotalSampleCount = other.mTotalSampleCount;
+
+        UpdateSamples();
+    }
+
+    return *this;
+}
+
 void SpeechData::Load(const std::string& path)
 {
     Clear();
@@ -45,27 +157,26 @@ void SpeechData::Load(const std::string& path)
 
             std::string features;
             key = SpeakerKey(label);
-            auto& userSamples = mSamples[SpeakerKey(label)];
+            unsigned int begin = mFrames->GetRowCount();
 
             while (std::getline(ssFeatures, features, ',')) {
-                userSamples.emplace_back();
+                DynamicVector<Real> frame;
 
                 std::stringstream ssFeature(features);
                 std::string feature;
 
                 while (std::getline(ssFeature, feature, ' ')) {
                     if (feature.size() > 0 && feature[0] != ' ') {
-                        userSamples.back().Push(ConvertString<Real>(feature));
+                        frame.Push(ConvertString<Real>(feature));
                     }
                 }
 
-                if (userSamples.back().GetSize() == 0) {
-                    userSamples.pop_back();
+                if (frame.GetSize() > 0) {
+                    AppendFrame(frame.GetData(), frame.GetSize());
                 }
             }
 
-            if (userSamples.size() == 0) {
-                mSamples.erase(key);
+            if (!AppendUtterance(key, begin, mFrames->GetRowCount())) {
                 std::cout << "Error: missing sample data." << std::endl;
             }
         }
@@ -73,6 +184,7 @@ void SpeechData::Load(const std::string& path)
         ++lineCounter;
     }
 
+    UpdateSamples();
     Validate();
 }
 
@@ -96,86 +208,61 @@ void SpeechData::Load(const std::string& path, unsigned int sl, unsigned int gl,
     unsigned int totalLines = sl+gl-1;
     unsigned int lc = 0;
 
-    while(std::getline(file, line)) {
-        if (lineCounter >= sl) {
-            SpeechDataBuffer buffer(const_cast<char*>(line.c_str()), line.size());
-            std::istream ssFeatures(&buffer);
-
-            std::string label;
-            SpeakerKey key;
+    // Jump directly to the start line.
+    if (sl > 1) {
+        LineIndex index;
 
-            if (ssFeatures >> label) {
-                std::string oldLabel = label;
+        if (index.Open(path)) {
+            if (sl > index.GetLineCount())
+                return;
 
-                if (alias.size() >= 3) {
-                    label[0] = alias[0];
-                    label[1] = alias[1];
-                    label[2] = alias[2];
-                }
+            file.seekg(index.GetOffset(sl));
+            lineCounter = sl;
+        }
+    }
 
-                if (train || multiplier > 1) {
-                    label.erase(3);
-                }
+    FeatureParser parser;
 
-                if (!train && multiplier > 1) {
-                    std::stringstream ss;
-                    ss << label << "_" << (lc / multiplier) + 1;
-                    label = ss.str();
+    Timer timer;
+    std::size_t parsedBytes = 0;
 
-                    std::cout << "Loading samples from '" << oldLabel << "' to '"
-                        << label << "'" << " mul " << multiplier
-                        << " (" << 100 * (lineCounter - sl + 1) / (totalLines - sl + 1)
-                        << "%)" << std::endl;
+    while(std::getline(file, line)) {
+        if (lineCounter >= sl) {
+            parsedBytes += line.size() + 1;
+
+            if (parser.Parse(line, maxFeatures)) {
+                std::string label = GetUtteranceLabel(parser.GetLabel(), lc,
+                    multiplier, train, alias,
+                    100 * (lineCounter - sl + 1) / (totalLines - sl + 1));
+
+                SpeakerKey key(label);
+                unsigned int begin = mFrames->GetRowCount();
+
+                if (mComputeDeltas && parser.IsUniform()
+                    && parser.GetFrameCount() > 0) {
+                    AppendDeltaFrames(parser.GetFrame(0), parser.GetFrameCount(),
+                        parser.GetFrameSize(0), 0, maxFeatures);
+                } else if (parser.IsUniform() && parser.GetFrameCount() > 0) {
+                    AppendFrames(parser.GetFrame(0), parser.GetFrameCount(),
+                        parser.GetFrameSize(0));
                 } else {
-                    std::cout << "Loading samples from '" << oldLabel << "' to '"
-                        << label << "'"
-                        << " (" << 100 * (lineCounter - sl + 1) / (totalLines - sl + 1) << "%)" << std::endl;
+                    for (unsigned int n = 0; n < parser.GetFrameCount(); ++n)
+                        AppendFrame(parser.GetFrame(n), parser.GetFrameSize(n));
                 }
 
-                std::string features;
-                key = SpeakerKey(label);
-                auto& userSamples = mSamples[key];
-                unsigned int totalVectors = 0;
-
-                // Feature vectors separated by commas.
-                while (std::getline(ssFeatures, features, ',')) {
-                    userSamples.emplace_back();
-
-                    SpeechDataBuffer buffer2(const_cast<char*>(features.c_str()),
-                        features.size());
-                    std::istream ssFeature(&buffer2);
-                    std::string feature;
-
-                    unsigned int featureCount = 0;
-
-                    // Features separated by spaces.
-                    while (std::getline(ssFeature, feature, ' ')) {
-                        if (feature.size() > 0 && feature[0] != ' ') {
-                            if (featureCount++ == maxFeatures)
-                                break;
-                            userSamples.back().Push(std::stof(feature));
-                        }
-                    }
-
-                    if (userSamples.back().GetSize() > 0) {
-                        ++totalVectors;
-                    } else {
-                        userSamples.pop_back();
-                    }
-                }
+                unsigned int end = mRemoveSilence
+                    ? RemoveSilence(begin) : mFrames->GetRowCount();
 
-                if (userSamples.size() == 0) {
-                    mSamples.erase(key);
+                if (!AppendUtterance(key, begin, end)) {
                     std::cout << "Error: missing sample data." << std::endl;
                 }
 
                 else {
                     // Per-utterance normalization.
-                    if (normalize) {
+                    if (normalize && end > begin) {
                         std::cout << "Normalizing utterance of size: "
-                            << totalVectors << "." << std::endl;
-                        Normalize(userSamples.end() - totalVectors,
-                            userSamples.end());
+                            << end - begin << "." << std::endl;
+                        Normalize(begin, end);
                     }
                 }
             }
@@ -189,6 +276,247 @@ void SpeechData::Load(const std::string& path, unsigned int sl, unsigned int gl,
 
         ++lineCounter;
     }
+
+    UpdateSamples();
+
+    Real time = timer.GetTimeElapsed();
+
+    if (time > 0.0f) {
+        std::cout << "Parsed " << parsedBytes / (1024.0f * 1024.0f) << " MB ("
+            << parsedBytes / (1024.0f * 1024.0f) / time << " MB/s): "
+            << path << std::endl;
+    }
+}
+
+bool SpeechData::LoadBinary(const std::string& path,
+    const std::string& sourcePath, unsigned int sl, unsigned int gl,
+    unsigned int multiplier, bool train, unsigned int maxFeatures,
+    bool normalize, const std::string& alias)
+{
+    FeatureFile file;
+
+    if (!file.Open(path, sourcePath)) {
+        std::cout << "Could not open feature file '" << path << "'." << std::endl;
+        return false;
+    }
+
+    if (train) {
+        std::cout << "Loading train samples (binary)." << std::endl;
+    } else {
+        std::cout << "Loading samples (binary), multiplier: " << multiplier
+                  << ", total lines: " << multiplier << "*" << gl << "=" << multiplier * gl << std::endl;
+    }
+
+    if (!train && multiplier > 1) {
+        gl = multiplier * gl;
+    }
+
+    // Line indexing starts at 1, utterance indexing at 0.
+    unsigned int first = Max(sl, 1u) - 1;
+    unsigned int last = Min(first + gl, file.GetUtteranceCount());
+    unsigned int dimensions = Min(maxFeatures, file.GetDimensionCount());
+
+    for (unsigned int u = first; u < last; ++u) {
+        std::string label = file.GetLabel(u);
+
+        if (label.empty())
+            continue;
+
+        label = GetUtteranceLabel(label, u - first, multiplier, train, alias,
+            100 * (u - first + 1) / (last - first));
+
+        SpeakerKey key(label);
+        unsigned int begin = mFrames->GetRowCount();
+
+        if (mComputeDeltas && dimensions > 0) {
+            AppendDeltaFrames(file.GetFrames(u), file.GetFrameCount(u),
+                file.GetDimensionCount(), file.GetDimensionCount(), maxFeatures);
+        } else if (dimensions > 0) {
+            AppendFrames(file.GetFrames(u), file.GetFrameCount(u), dimensions,
+                file.GetDimensionCount());
+        }
+
+        unsigned int end = mRemoveSilence
+            ? RemoveSilence(begin) : mFrames->GetRowCount();
+
+        if (!AppendUtterance(key, begin, end)) {
+            std::cout << "Error: missing sample data." << std::endl;
+        }
+
+        else {
+            // Per-utterance normalization.
+            if (normalize && end > begin) {
+                std::cout << "Normalizing utterance of size: "
+                    << end - begin << "." << std::endl;
+                Normalize(begin, end);
+            }
+        }
+    }
+
+    UpdateSamples();
+
+    return true;
+}
+
+void SpeechData::Merge(SpeechData& other)
+{
+    unsigned int offset = mFrames->GetRowCount();
+    unsigned int rows = other.mFrames->GetRowCount();
+
+    if (rows > 0) {
+        AppendFrames(other.mFrames->GetRow(0), rows,
+            other.mFrames->GetColumnCount());
+    }
+
+    // Frames are appended in one block, shift the utterance ranges.
+    if (mFrames->GetRowCount() == offset + rows) {
+        for (const auto& entry : other.mUtterances) {
+            auto& utterances = mUtterances[entry.first];
+
+            for (const auto& utterance : entry.second) {
+                utterances.push_back(
+                    { utterance.begin + offset, utterance.end + offset });
+            }
+        }
+    }
+
+    mFrameSizeMismatch = mFrameSizeMismatch || other.mFrameSizeMismatch;
+
+    other.Clear();
+
+    UpdateSamples();
+}
+
+void SpeechData::AddUtterance(const SpeakerKey& key,
+    const FeatureMatrix& frames)
+{
+    unsigned int begin = mFrames->GetRowCount();
+
+    if (frames.GetRowCount() > 0) {
+        AppendFrames(frames.GetRow(0), frames.GetRowCount(),
+            frames.GetColumnCount());
+    }
+
+    AppendUtterance(key, begin, mFrames->GetRowCount());
+
+    UpdateSamples();
+}
+
+template<typename T>
+void SpeechData::AppendFrames(const T* values, unsigned int count,
+    unsigned int size, unsigned int stride)
+{
+    DetachFrames();
+
+    if (mFrames->GetRowCount() == 0 && mFrames->GetColumnCount() != size)
+        mFrames->Clear(size);
+
+    if (size != mFrames->GetColumnCount()) {
+        mFrameSizeMismatch = true;
+        return;
+    }
+
+    if (stride == 0)
+        stride = size;
+
+    Real* row = mFrames->AppendRows(count);
+
+    for (unsigned int n = 0; n < count; ++n) {
+        for (unsigned int d = 0; d < size; ++d)
+            row[d] = values[d];
+
+        row += size;
+        values += stride;
+    }
+}
+
+template<typename T>
+void SpeechData::AppendFrame(const T* values, unsigned int size)
+{
+    AppendFrames(values, 1, size);
+}
+
+template<typename T>
+void SpeechData::AppendDeltaFrames(const T* values, unsigned int count,
+    unsigned int size, unsigned int stride, unsigned int maxFeatures)
+{
+    if (stride == 0)
+        stride = size;
+
+    FeatureMatrix coefficients(size);
+    Real* row = coefficients.AppendRows(count);
+
+    for (unsigned int n = 0; n < count; ++n) {
+        for (unsigned int d = 0; d < size; ++d)
+            row[d] = values[d];
+
+        row += size;
+        values += stride;
+    }
+
+    // 0: static only, 1: with deltas, 2: with deltas and delta-deltas.
+    unsigned int order = (size > 0) ? Min((maxFeatures + size - 1) / size, 3u) - 1 : 0;
+
+    FeatureMatrix features;
+    AddDeltas(coefficients.GetRow(0), count, size, 0, order, features);
+
+    AppendFrames(features.GetRow(0), count,
+        Min(maxFeatures, features.GetColumnCount()), features.GetColumnCount());
+}
+
+bool SpeechData::AppendUtterance(const SpeakerKey& key, unsigned int begin,
+    unsigned int end)
+{
+    if (end > begin) {
+        mUtterances[key].push_back({ begin, end });
+        return true;
+    }
+
+    return mUtterances.find(key) != mUtterances.end();
+}
+
+unsigned int SpeechData::RemoveSilence(unsigned int begin)
+{
+    unsigned int end = mFrames->GetRowCount();
+
+    if (end <= begin)
+        return end;
+
+    DetachFrames();
+
+    unsigned int kept = RemoveSilentFrames(mFrames->GetRow(begin), end - begin,
+        mFrames->GetColumnCount());
+
+    mFrames->Truncate(begin + kept);
+
+    return begin + kept;
+}
+
+void SpeechData::DetachFrames()
+{
+    if (mFrames.use_count() > 1)
+        mFrames = std::make_shared<FeatureMatrix>(*mFrames);
+}
+
+void SpeechData::UpdateSamples()
+{
+    mSamples.clear();
+
+    for (const auto& entry : mUtterances) {
+        auto& userSamples = mSamples[entry.first];
+        std::size_t count = 0;
+
+        for (const auto& utterance : entry.second)
+            count += utterance.end - utterance.begin;
+
+        userSamples.reserve(count);
+
+        for (const auto& utterance : entry.second) {
+            for (unsigned int row = utterance.begin; row < utterance.end; ++row)
+                userSamples.push_back(
+                    mFrames->GetRowView(row, mSampleDimensionCount));
+        }
+    }
 }
 
 void SpeechData::Validate()
@@ -198,6 +526,12 @@ void SpeechData::Validate()
 
     std::cout << "Validating speech data..." << std::endl;
 
+    if (mFrameSizeMismatch) {
+        std::cout << "Speech data not valid: feature count mismatch."
+                  << std::endl;
+        return;
+    }
+
     unsigned int featureCount = 0;
 
     if (mSamples.size() > 0
@@ -229,6 +563,10 @@ void SpeechData::Validate()
 void SpeechData::Clear()
 {
     mSamples.clear();
+    mUtterances.clear();
+    mFrames = std::make_shared<FeatureMatrix>();
+    mSampleDimensionCount = 0;
+    mFrameSizeMismatch = false;
     mConsistent = true;
     mTotalSampleCount = 0;
     mDimensionCount = 0;
@@ -262,36 +600,73 @@ FeatureNormalizationType SpeechData::GetNormalizationType() const
     return mNormalizationType;
 }
 
+void SpeechData::SetNormalizationWindow(unsigned int windowSize)
+{
+    mNormalizationWindow = windowSize;
+}
+
+unsigned int SpeechData::GetNormalizationWindow() const
+{
+    return mNormalizationWindow;
+}
+
+void SpeechData::SetComputeDeltas(bool computeDeltas)
+{
+    mComputeDeltas = computeDeltas;
+}
+
+bool SpeechData::GetComputeDeltas() const
+{
+    return mComputeDeltas;
+}
+
+void SpeechData::SetRemoveSilence(bool removeSilence)
+{
+    mRemoveSilence = removeSilence;
+}
+
+bool SpeechData::GetRemoveSilence() const
+{
+    return mRemoveSilence;
+}
+
 void SpeechData::CMVN(
     std::vector < DynamicVector<Real> >::iterator beginIt,
     std::vector < DynamicVector<Real> >::iterator endIt)
 {
+    if (beginIt == endIt)
+        return;
+
+    unsigned int dimensionCount = beginIt->GetSize();
+
+    // Get mean & deviation over all samples in a single pass.
+    FeatureStatistics statistics(dimensionCount);
+
+    for (auto it = beginIt; it != endIt; it++)
+        statistics.Add(*it);
+
     DynamicVector<Real> means;
     DynamicVector<Real> deviations;
 
-    means.Resize(beginIt->GetSize());
-    deviations.Resize(beginIt->GetSize());
+    statistics.GetMeans(means);
+    statistics.GetDeviations(deviations);
 
-    // Normalize dimensions separately.
-    for (unsigned int d = 0; d < beginIt->GetSize(); d++) {
-        std::vector<Real> values;
-
-        for (auto it = beginIt; it != endIt; it++) {
-            values.push_back((*it)[d]);
-        }
+    // The samples view the frames, normalize them in place.
+    for (auto it = beginIt; it != endIt; it++)
+        it->Assign((*it - means) / deviations);
+}
 
-        // Get mean & deviation over all samples.
-        Real mean = Mean(values);
-        Real deviation = Deviation(values, mean);
+void SpeechData::SlidingWindowCMVN(
+    std::vector < DynamicVector<Real> >::iterator beginIt,
+    std::vector < DynamicVector<Real> >::iterator endIt)
+{
+    if (beginIt == endIt)
+        return;
 
-        means[d] = mean;
-        deviations[d] = deviation;
-    }
+    SlidingCMVN normalizer(beginIt->GetSize(), mNormalizationWindow);
 
-    for (auto it = beginIt; it != endIt; it++) {
-        it->Subtract(means);
-        it->Divide(deviations);
-    }
+    for (auto it = beginIt; it != endIt; it++)
+        normalizer.Normalize(*it);
 }
 
 void SpeechData::Normalize(
@@ -304,13 +679,34 @@ void SpeechData::Normalize(
     case FeatureNormalizationType::CEPSTRAL_MEAN_VARIANCE:
         CMVN(beginIt, endIt);
         break;
+    case FeatureNormalizationType::SLIDING_CEPSTRAL_MEAN_VARIANCE:
+        SlidingWindowCMVN(beginIt, endIt);
+        break;
     default:
         std::cout << "Unknown feature normalization type." << std::endl;
     }
 }
 
+void SpeechData::Normalize(unsigned int beginRow, unsigned int endRow)
+{
+    std::vector< DynamicVector<Real> > rows;
+
+    DetachFrames();
+
+    for (unsigned int row = beginRow; row < endRow; ++row)
+        rows.push_back(mFrames->GetRowView(row));
+
+    Normalize(rows.begin(), rows.end());
+}
+
 void SpeechData::Normalize()
 {
+    // Do not modify shared frames.
+    if (mFrames.use_count() > 1) {
+        DetachFrames();
+        UpdateSamples();
+    }
+
     // Normalize entry by entry.
     for (auto& sample : mSamples) {
         Normalize(sample.second.begin(), sample.second.end());
@@ -333,32 +729,131 @@ SpeechData::GetSamples() const
     return mSamples;
 }
 
+std::vector< DynamicVector<Real> > SpeechData::GetAllSamples()
+{
+    std::vector< DynamicVector<Real> > samples;
+
+    samples.reserve(mFrames->GetRowCount());
+
+    for (auto& entry : mSamples) {
+        for (auto& sample : entry.second)
+            samples.emplace_back(sample.GetData(), sample.GetSize());
+    }
+
+    return samples;
+}
+
 void LoadTextSamples(const std::string& folder,
     const std::shared_ptr<SpeechData>& data, unsigned int sf, unsigned int gf,
     unsigned int sl, unsigned int gl, unsigned int multiplier, bool train)
+{
+    std::string finalFolder;
+    unsigned int maxFeatures;
+    FeatureNormalizationType normalizationType;
+    bool computeDeltas;
+    bool removeSilence;
+
+    if (!ParseSamplesFolder(folder, finalFolder, maxFeatures, normalizationType,
+        computeDeltas, removeSilence))
+        return;
+
+    // Resolve speakers and files through the speaker manifest.
+    auto manifest = SpeakerManifest::Get(finalFolder);
+
+    std::vector<std::string> aliases;
+    std::vector<std::string> files;
+
+    for (unsigned int i = 0; i < gf; i++) {
+        const SpeakerManifest::Entry* entry = manifest->GetEntry(sf + i);
+
+        aliases.push_back(GetSpeakerString(sf + i, folder));
+
+        if (entry != nullptr)
+            files.push_back(finalFolder + "/" + entry->file);
+        else
+            files.push_back(finalFolder + "/samples_" + toString(sf + i) + ".txt");
+    }
+
+    // Load files concurrently into separate data sets.
+    std::vector<SpeechData> parts(gf);
+
+    // Messages are printed in file order after all files are loaded.
+    ParallelForBuffered(gf, [&](unsigned int i) {
+        const std::string& file = files[i];
+        std::string binaryFile = GetBinarySamplesPath(file);
+
+        parts[i].SetComputeDeltas(computeDeltas);
+        parts[i].SetRemoveSilence(removeSilence);
+
+        // Prefer the preconverted binary features unless they are older
+        // than the text file. Without a text file the binary one is used
+        // as is.
+        std::string sourceFile = FileExists(file) ? file : "";
+
+        if (!FileExists(binaryFile)
+            || !parts[i].LoadBinary(binaryFile, sourceFile, sl, gl,
+                multiplier, train, maxFeatures, false, aliases[i])) {
+            parts[i].Load(file, sl, gl, multiplier, train, maxFeatures, false,
+                aliases[i]);
+        }
+    });
+
+    // Merge in file order to keep the sample order deterministic.
+    data->Clear();
+    for (auto& part : parts)
+        data->Merge(part);
+    data->Validate();
+
+    std::cout << "Dimensions: " << data->GetDimensionCount() << std::endl;
+
+    if (normalizationType == FeatureNormalizationType::CEPSTRAL_MEAN_VARIANCE) {
+        std::cout << "Normalizing (CMVN)..." << std::endl;
+        data->SetNormalizationType(normalizationType);
+        data->Normalize();
+    } else if (normalizationType
+        == FeatureNormalizationType::SLIDING_CEPSTRAL_MEAN_VARIANCE) {
+        std::cout << "Normalizing (sliding CMVN, window "
+            << data->GetNormalizationWindow() << ")..." << std::endl;
+        data->SetNormalizationType(normalizationType);
+        data->Normalize();
+    }
+}
+
+bool ParseSamplesFolder(const std::string& folder, std::string& baseFolder,
+    unsigned int& maxFeatures, FeatureNormalizationType& normalizationType,
+    bool& computeDeltas, bool& removeSilence)
 {
     if (folder.size() == 0) {
         std::cout << "Could not load samples: Missing folder name." << std::endl;
-        return;
+        return false;
     }
 
-    bool cmvn = false;
-    unsigned int maxFeatures = 39;
+    normalizationType = FeatureNormalizationType::NONE;
+    maxFeatures = 39;
+    computeDeltas = false;
+    removeSilence = false;
 
     std::stringstream ss(folder);
 
-    std::string finalFolder;
-
-    if (!std::getline(ss, finalFolder, '_')) {
+    if (!std::getline(ss, baseFolder, '_')) {
         std::cout << "Invalid folder name." << std::endl;
-        return;
+        return false;
     }
 
     std::string str;
 
     while (std::getline(ss, str, '_')) {
         if (str == "cmvn")
-            cmvn = true;
+            normalizationType = FeatureNormalizationType::CEPSTRAL_MEAN_VARIANCE;
+
+        else if (str == "scmvn")
+            normalizationType = FeatureNormalizationType::SLIDING_CEPSTRAL_MEAN_VARIANCE;
+
+        else if (str == "deltas")
+            computeDeltas = true;
+
+        else if (str == "vad")
+            removeSilence = true;
 
         else if (str.size() > 0 && str[0] == 'f') {
             str.erase(0, 1);
@@ -371,22 +866,7 @@ void LoadTextSamples(const std::string& folder,
         }
     }
 
-    data->Clear();
-    for (unsigned int i = 0; i < gf; i++)
-    {
-        std::string file = finalFolder + "/samples_" + toString(sf+i) + ".txt";
-        std::cout << file << std::endl;
-        data->Load(file, sl, gl, multiplier, train, maxFeatures, false,
-            GetSpeakerString(sf + i, folder));
-    }
-    data->Validate();
-
-    std::cout << "Dimensions: " << data->GetDimensionCount() << std::endl;
-
-    if (cmvn) {
-        std::cout << "Normalizing (CMVN)..." << std::endl;
-        data->Normalize();
-    }
+    return true;
 }
 
 std::string GetSpeakerString(unsigned int index, const std::string& folder)
@@ -406,38 +886,15 @@ std::string GetSpeakerString(unsigned int index, const std::string& folder)
         return "";
     }
 
-    static std::vector<std::string> speakerFiles;
-    static bool speakerFilesScanned = false;
-
-    if (!speakerFilesScanned) {
-        for (unsigned int i = 1; i <= 109; ++i) {
-            std::string fname = finalFolder + "/samples_" + toString(i) + ".txt";
-
-            std::ifstream infile(fname);
-
-            if (infile.good()) {
-                std::string line;
-                getline(infile, line);
-
-                if (line.size() >= 3) {
-                    std::string id;
-                    id += line[0];
-                    id += line[1];
-                    id += line[2];
+    const SpeakerManifest::Entry* entry =
+        SpeakerManifest::Get(finalFolder)->GetEntry(index);
 
-                    speakerFiles.push_back(id);
-
-                    std::cout << "Scanned: " << i << ":" << id << std::endl;
-                } else {
-                    std::cout << "Scanning failed: insufficient data." << std::endl;
-                }
-            }
-        }
-
-        speakerFilesScanned = true;
+    if (entry == nullptr) {
+        std::cout << "Speaker " << index << " not found." << std::endl;
+        return "";
     }
 
-    return speakerFiles[index - 1];
+    return entry->id;
 
 #else
     return toString(index);
@@ -10,6 +10,12 @@
 #include "GMMRecognizer.h"
 #include "Timer.h"
 
+namespace
+{
+    // Number of cached test data sets (cycles), train data is always kept.
+    const std::size_t MaxTestSamples = 4;
+}
+
 TestEngine::TestEngine()
 {
 
@@ -211,6 +217,11 @@ void TestEngine::Run(const std::string& file)
                     test.scoreNormalizationType = ScoreNormalizationType::TEST_ZERO;
                 } else if (feature == "-wt") {
                     test.weighting = true;
+                } else if (feature == "-top") {
+                    if (!(ssLine >> test.selection)) {
+                        std::cout << "Error: invalid selection count." << std::endl;
+                        return;
+                    }
                 } else if (feature == "-ubm") {
                     test.ubm = true;
                 } else if (feature == "-o") {
@@ -278,12 +289,35 @@ void TestEngine::Run(const std::string& file)
         if (a.weighting < b.weighting) return true;
         if (a.weighting > b.weighting) return false;
 
+        if (a.selection < b.selection) return true;
+        if (a.selection > b.selection) return false;
+
         if (a.ubm < b.ubm) return true;
         if (a.ubm > b.ubm) return false;
 
         return (a.recognizerType < b.recognizerType);
     });
 
+    // Feature sets of the same folder are loaded once using the widest set.
+    mSamples.clear();
+    mTestSamples.clear();
+    mFeatureCounts.clear();
+
+    for (const auto& test : tests) {
+        std::string baseFolder;
+        unsigned int maxFeatures;
+        FeatureNormalizationType normalizationType;
+        bool computeDeltas;
+        bool removeSilence;
+
+        if (ParseSamplesFolder(test.features, baseFolder, maxFeatures,
+            normalizationType, computeDeltas, removeSilence)) {
+            auto& featureCount = mFeatureCounts[GetSamplesKey(baseFolder,
+                normalizationType, computeDeltas, removeSilence)];
+            featureCount = Max(featureCount, maxFeatures);
+        }
+    }
+
     std::string previousFeatures;
 
     std::shared_ptr<SpeechData> ubmData;
@@ -368,10 +402,8 @@ void TestEngine::Run(const std::string& file)
             it->trainSl  != previousIt->trainSl  ||
             it->trainGl  != previousIt->trainGl) {
             // Load speaker data.
-            trainData = std::make_shared<SpeechData>();
-            LoadTextSamples(
+            trainData = LoadSamples(
                 it->features,
-                trainData,
                 it->trainSf,
                 it->trainGf,
                 it->trainSl,
@@ -384,14 +416,14 @@ void TestEngine::Run(const std::string& file)
         if (previousIt   == tests.end() ||
             it->features != previousIt->features) {
             // Load ubm data from a different set of speakers.
-            ubmData = std::make_shared<SpeechData>();
-            LoadTextSamples(it->features, ubmData, ubmSf, ubmGf, ubmSl, ubmGl, 1, true);
+            ubmData = LoadSamples(it->features, ubmSf, ubmGf, ubmSl, ubmGl, 1, true);
         }
 
         if (it->recognizerType == RecognizerType::VQ) {
             vq->SetWeightingEnabled(it->weighting);
             recognizer = vq;
         } else if (it->recognizerType == RecognizerType::GMM) {
+            gmm->SetSelectionCount(it->selection);
             recognizer = gmm;
         } else {
             std::cout << "Unknown recognizer type." << std::endl;
@@ -459,6 +491,9 @@ void TestEngine::Run(const std::string& file)
 
         previousIt = it;
     }
+
+    mSamples.clear();
+    mTestSamples.clear();
 }
 
 void TestEngine::RecognizePop(
@@ -467,10 +502,8 @@ void TestEngine::RecognizePop(
 {
     std::string resultsFileName = test.id + "_rec" + ".txt";
     std::ofstream results(resultsFileName, std::ios_base::app);
-    auto testData = std::make_shared<SpeechData>();
-
     // Test utterances
-    LoadTextSamples(test.features, testData, test.testSf,
+    auto testData = LoadSamples(test.features, test.testSf,
         test.cycles * test.testGf, test.testSl, test.testGl, test.multiplier, false);
 
     for (unsigned int i = 1; i <= test.cycles ; i++) {
@@ -538,10 +571,8 @@ void TestEngine::Recognize(
 
     std::ofstream results(resultsFileName, std::ios_base::app);
 
-    auto testData = std::make_shared<SpeechData>();
-
     // Test utterances
-    LoadTextSamples(test.features, testData, test.testSf, test.testGf,
+    auto testData = LoadSamples(test.features, test.testSf, test.testGf,
         test.testSl, test.testGl, test.multiplier, false);
 
     unsigned int correct = 0;
@@ -574,7 +605,7 @@ void TestEngine::Recognize(
         std::cout << i + 1 << "/" << test.cycles << std::endl;
 
         // Test utterances
-        LoadTextSamples(test.features, testData, sf, test.testGf, test.testSl,
+        testData = LoadSamples(test.features, sf, test.testGf, test.testSl,
             test.testGl, test.multiplier, false);
 
         Timer timer;
@@ -628,8 +659,7 @@ void TestEngine::Verify(
     }
     recognizer->SelectImpostorModels(impostors);
 
-    auto testData = std::make_shared<SpeechData>();
-    auto testData2 = std::make_shared<SpeechData>();
+    std::shared_ptr<SpeechData> testData;
 
     unsigned int sf = test.testSf;
 
@@ -662,7 +692,7 @@ void TestEngine::Verify(
         std::vector<Real> correctScores;
         std::vector<Real> incorrectScores;
 
-        LoadTextSamples(test.features, testData, sf, test.testGf, test.testSl,
+        testData = LoadSamples(test.features, sf, test.testGf, test.testSl,
             test.testGl, test.multiplier, false);
 
         Timer timer;
@@ -713,6 +743,85 @@ void TestEngine::Verify(
                  << incorrectTrials  << std::endl;
 }
 
+std::shared_ptr<SpeechData> TestEngine::LoadSamples(
+    const std::string& features, unsigned int sf, unsigned int gf,
+    unsigned int sl, unsigned int gl, unsigned int multiplier, bool train)
+{
+    std::string baseFolder;
+    unsigned int maxFeatures;
+    FeatureNormalizationType normalizationType;
+    bool computeDeltas;
+    bool removeSilence;
+
+    if (!ParseSamplesFolder(features, baseFolder, maxFeatures, normalizationType,
+        computeDeltas, removeSilence))
+        return std::make_shared<SpeechData>();
+
+    // Tests are sorted by features, a new folder will not be seen again.
+    if (baseFolder != mSamplesFolder) {
+        mSamples.clear();
+        mTestSamples.clear();
+        mSamplesFolder = baseFolder;
+    }
+
+    std::string samplesKey = GetSamplesKey(baseFolder, normalizationType,
+        computeDeltas, removeSilence);
+    unsigned int featureCount = Max(maxFeatures, mFeatureCounts[samplesKey]);
+
+    std::stringstream ss;
+    ss << samplesKey << " " << sf << " " << gf << " " << sl << " " << gl
+       << " " << multiplier << " " << train;
+
+    std::string key = ss.str();
+
+    if (!train) {
+        // Test data changes every cycle, keep only the recently used sets.
+        auto it = std::find(mTestSamples.begin(), mTestSamples.end(), key);
+
+        if (it != mTestSamples.end())
+            mTestSamples.erase(it);
+
+        mTestSamples.insert(mTestSamples.begin(), key);
+
+        if (mTestSamples.size() > MaxTestSamples) {
+            mSamples.erase(mTestSamples.back());
+            mTestSamples.pop_back();
+        }
+    }
+
+    auto& data = mSamples[key];
+
+    if (data == nullptr) {
+        std::string folder = GetSamplesKey(
+            baseFolder + "_f" + toString(featureCount), normalizationType,
+            computeDeltas, removeSilence);
+
+        data = std::make_shared<SpeechData>();
+        LoadTextSamples(folder, data, sf, gf, sl, gl, multiplier, train);
+    }
+
+    return std::make_shared<SpeechData>(*data, maxFeatures);
+}
+
+std::string TestEngine::GetSamplesKey(const std::string& baseFolder,
+    FeatureNormalizationType normalizationType, bool computeDeltas,
+    bool removeSilence)
+{
+    std::string key = computeDeltas ? baseFolder + "_deltas" : baseFolder;
+
+    if (removeSilence)
+        key += "_vad";
+
+    switch (normalizationType) {
+    case FeatureNormalizationType::CEPSTRAL_MEAN_VARIANCE:
+        return key + "_cmvn";
+    case FeatureNormalizationType::SLIDING_CEPSTRAL_MEAN_VARIANCE:
+        return key + "_scmvn";
+    default:
+        return key;
+    }
+}
+
 std::string TestEngine::GetLabel(const Test& test)
 {
     if (test.label.empty()) {
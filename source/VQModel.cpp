@@ -4,6 +4,8 @@
 
 #include "VQModel.h"
 
+#include "CentroidSearch.h"
+
 VQModel::VQModel()
 {
 
@@ -20,6 +22,18 @@ void VQModel::ResetWeights()
         weight = 1.0f;
 }
 
+void VQModel::AllocateCentroids(unsigned int count, unsigned int dimensions)
+{
+    // All centroids of a model in a few aligned blocks.
+    mPool.Release();
+
+    mClusterCentroids.clear();
+    mClusterCentroids.reserve(count);
+
+    for (unsigned int c = 0; c < count; c++)
+        mClusterCentroids.emplace_back(mPool, dimensions);
+}
+
 void VQModel::Init()
 {
     if (mClusterCentroids.size() != GetOrder())
@@ -39,7 +53,14 @@ void VQModel::Train(const std::vector< DynamicVector<Real> >& samples,
     mClusterWeights.resize(GetOrder());
     ResetWeights();
     std::vector<unsigned int> indices;
-    lbg.Cluster(samples, indices, mClusterCentroids, mClusterSizes);
+    std::vector< DynamicVector<Real> > centroids;
+    lbg.Cluster(samples, indices, centroids, mClusterSizes);
+
+    AllocateCentroids(centroids.size(),
+        centroids.empty() ? 0 : centroids[0].GetSize());
+
+    for (unsigned int c = 0; c < centroids.size(); c++)
+        mClusterCentroids[c].Assign(centroids[c]);
 }
 
 void VQModel::Adapt(const std::shared_ptr<Model>& other,
@@ -58,39 +79,53 @@ void VQModel::Adapt(const std::shared_ptr<Model>& other,
 
     std::vector<unsigned int> indices(samples.size());
 
+    unsigned int dimensions = model->GetDimensionCount();
+
+    // Centroid sums.
+    MemoryPool pool;
+    std::vector< DynamicVector<Accumulator> > sums;
+
+    sums.reserve(GetOrder());
+
+    for (unsigned int c = 0; c < GetOrder(); c++)
+        sums.emplace_back(pool, dimensions);
+
     // Initialize the feature vectors of the centroids.
+    AllocateCentroids(GetOrder(), dimensions);
 
     for (unsigned int c = 0; c < GetOrder(); c++)
-        mClusterCentroids[c] = model->mClusterCentroids[c];
+        mClusterCentroids[c].Assign(model->mClusterCentroids[c]);
 
     // Do the iterations.
     for (unsigned int i = 0; i < iterations; i++) {
         //Find the closest centroid to each sample
-        for (unsigned int n = 0; n < samples.size(); n++) {
-            Real minDist = std::numeric_limits<Real>::max();
-            for (unsigned int c = 0; c < GetOrder(); c++) {
-                Real dist = samples[n].Distance(mClusterCentroids[c]);
-                if (dist < minDist) {
-                    minDist = dist;
-                    indices[n] = c;
-                }
-            }
-        }
+        CentroidSearch search(mClusterCentroids, GetOrder());
+
+        for (unsigned int n = 0; n < samples.size(); n++)
+            indices[n] = search.Find(samples[n]);
 
         //Set the centroids to the average of the samples in each centroid
         for (unsigned int c = 0; c < GetOrder(); ++c) {
-            mClusterCentroids[c].Assign(0.0f);
+            sums[c].Assign(0.0f);
             mClusterSizes[c] = 0;
         }
 
         for (unsigned int s = 0; s < samples.size(); ++s) {
-            mClusterCentroids[indices[s]].Add(samples[s]);
+            auto& sum = sums[indices[s]];
+
+            for (unsigned int d = 0; d < dimensions; ++d)
+                sum[d] += samples[s][d];
+
             ++mClusterSizes[indices[s]];
         }
 
         for (unsigned int c = 0; c < GetOrder(); ++c) {
-            if (mClusterSizes[c] > 0) {
-                mClusterCentroids[c].Multiply(1.0f / static_cast<Real>(mClusterSizes[c]));
+            Accumulator invSize = (mClusterSizes[c] > 0)
+                ? 1.0f / static_cast<Accumulator>(mClusterSizes[c]) : 0.0f;
+
+            for (unsigned int d = 0; d < dimensions; ++d) {
+                mClusterCentroids[c][d] =
+                    static_cast<Real>(sums[c][d] * invSize);
             }
         }
 
@@ -99,11 +134,8 @@ void VQModel::Adapt(const std::shared_ptr<Model>& other,
             Real size = static_cast<Real>(mClusterSizes[c]);
             Real w = size / (size + static_cast<Real>(relevanceFactor));
 
-            DynamicVector<Real> ubmc = model->mClusterCentroids[c];
-            ubmc.Multiply(1.0f - w);
-
-            mClusterCentroids[c].Multiply(w);
-            mClusterCentroids[c].Add(ubmc);
+            mClusterCentroids[c].Assign(w * mClusterCentroids[c]
+                + (1.0f - w) * model->mClusterCentroids[c]);
         }
     }
 }
@@ -152,30 +184,12 @@ Real VQModel::GetDistortion(const std::vector< DynamicVector<Real> >& samples) c
     auto& sizes = mClusterSizes;
     auto& weights = mClusterWeights;
 
-    Real dist = 0.0f;
-
-    for (unsigned int s = 0; s < samples.size(); ++s) {
-        auto& sample = samples[s];
-
-        Real minDist = std::numeric_limits<Real>::max();
-        unsigned int minC = -1;
-
-        for (unsigned int c = 0; c < centroids.size(); ++c) {
-            if (sizes[c] == 0)
-                continue;
-
-            dist = sample.Distance(centroids[c]);
+    CentroidSearch search(centroids, centroids.size(), &sizes);
 
-            if (dist < minDist) {
-                minDist = dist;
-                minC = c;
-            }
-        }
-
-        mClusterSamples[s] = minC;
-    }
+    for (unsigned int s = 0; s < samples.size(); ++s)
+        mClusterSamples[s] = search.Find(samples[s]);
 
-    Real distortion = 0.0f;
+    Accumulator distortion = 0.0f;
     for (unsigned int s = 0; s < samples.size(); ++s)
         distortion += samples[s].Distance(centroids[mClusterSamples[s]]);
 
@@ -191,37 +205,19 @@ Real VQModel::GetWeightedSimilarity(const std::vector< DynamicVector<Real> >& sa
     auto& sizes = mClusterSizes;
     auto& weights = mClusterWeights;
 
-    Real dist = 0.0f;
+    CentroidSearch search(centroids, centroids.size(), &sizes);
 
-    for (unsigned int s = 0; s < samples.size(); ++s) {
-        auto& sample = samples[s];
-
-        Real minDist = std::numeric_limits<Real>::max();
-        unsigned int minC = -1;
-
-        for (unsigned int c = 0; c < centroids.size(); ++c) {
-            if (sizes[c] == 0)
-                continue;
-
-            dist = sample.Distance(centroids[c]);
-
-            if (dist < minDist) {
-                minDist = dist;
-                minC = c;
-            }
-        }
-
-        mClusterSamples[s] = minC;
-    }
+    for (unsigned int s = 0; s < samples.size(); ++s)
+        mClusterSamples[s] = search.Find(samples[s]);
 
-    Real distortion = 0.0f;
+    Accumulator distortion = 0.0f;
 
     for (unsigned int s = 0; s < samples.size(); ++s) {
         distortion += weights[mClusterSamples[s]]
             / samples[s].Distance(centroids[mClusterSamples[s]]);
     }
 
-    return distortion / static_cast<Real>(samples.size());
+    return distortion / static_cast<Accumulator>(samples.size());
 }
 
 Real VQModel::GetScore(const std::vector< DynamicVector<Real> >& samples) const
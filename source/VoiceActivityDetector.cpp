@@ -0,0 +1,168 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "VoiceActivityDetector.h"
+
+VoiceActivityDetector::VoiceActivityDetector(unsigned int sampleRate,
+    Real threshold, unsigned int hangover)
+    : mThreshold(threshold),
+    mHangover(hangover)
+{
+    Reset(sampleRate);
+}
+
+VoiceActivityDetector::~VoiceActivityDetector()
+{
+
+}
+
+void VoiceActivityDetector::Reset(unsigned int sampleRate)
+{
+    // Rounded as in the script.
+    mFrameLength = (sampleRate * DefaultFrameDuration + 500) / 1000;
+
+    if (mFrameLength == 0)
+        mFrameLength = 1;
+
+    mBuffer.clear();
+    mBuffer.reserve(mFrameLength);
+
+    mRemaining = 0;
+    mFrameCount = 0;
+    mActiveFrameCount = 0;
+}
+
+void VoiceActivityDetector::SetThreshold(Real threshold)
+{
+    mThreshold = threshold;
+}
+
+Real VoiceActivityDetector::GetThreshold() const
+{
+    return mThreshold;
+}
+
+void VoiceActivityDetector::SetHangover(unsigned int hangover)
+{
+    mHangover = hangover;
+}
+
+unsigned int VoiceActivityDetector::GetHangover() const
+{
+    return mHangover;
+}
+
+unsigned int VoiceActivityDetector::GetFrameLength() const
+{
+    return mFrameLength;
+}
+
+bool VoiceActivityDetector::IsActive(Accumulator energy)
+{
+    ++mFrameCount;
+
+    if (energy >= mThreshold) {
+        mRemaining = mHangover;
+    } else if (mRemaining > 0) {
+        --mRemaining;
+    } else {
+        return false;
+    }
+
+    ++mActiveFrameCount;
+    return true;
+}
+
+void VoiceActivityDetector::Process(const Real* samples, unsigned int count,
+    std::vector<Real>& output)
+{
+    // Complete a frame started by the previous block.
+    if (!mBuffer.empty()) {
+        unsigned int size = Min(count,
+            mFrameLength - static_cast<unsigned int>(mBuffer.size()));
+
+        mBuffer.insert(mBuffer.end(), samples, samples + size);
+        samples += size;
+        count -= size;
+
+        if (mBuffer.size() < mFrameLength)
+            return;
+
+        ProcessFrame(mBuffer.data(), mFrameLength, output);
+        mBuffer.clear();
+    }
+
+    // Whole frames directly from the block.
+    while (count >= mFrameLength) {
+        ProcessFrame(samples, mFrameLength, output);
+        samples += mFrameLength;
+        count -= mFrameLength;
+    }
+
+    mBuffer.insert(mBuffer.end(), samples, samples + count);
+}
+
+void VoiceActivityDetector::Flush(std::vector<Real>& output)
+{
+    if (!mBuffer.empty()) {
+        ProcessFrame(mBuffer.data(), static_cast<unsigned int>(mBuffer.size()),
+            output);
+        mBuffer.clear();
+    }
+}
+
+unsigned int VoiceActivityDetector::GetFrameCount() const
+{
+    return mFrameCount;
+}
+
+unsigned int VoiceActivityDetector::GetActiveFrameCount() const
+{
+    return mActiveFrameCount;
+}
+
+void VoiceActivityDetector::ProcessFrame(const Real* samples,
+    unsigned int count, std::vector<Real>& output)
+{
+    Accumulator energy = 0.0f;
+
+    for (unsigned int i = 0; i < count; ++i)
+        energy += static_cast<Accumulator>(samples[i]) * samples[i];
+
+    if (IsActive(energy / count))
+        output.insert(output.end(), samples, samples + count);
+}
+
+unsigned int RemoveSilentFrames(Real* frames, unsigned int count,
+    unsigned int stride, Real range, unsigned int hangover)
+{
+    if (count == 0)
+        return 0;
+
+    Real maxEnergy = frames[0];
+
+    for (unsigned int n = 1; n < count; ++n)
+        maxEnergy = Max(maxEnergy, frames[static_cast<std::size_t>(n) * stride]);
+
+    VoiceActivityDetector detector(0, maxEnergy - range, hangover);
+    unsigned int kept = 0;
+
+    for (unsigned int n = 0; n < count; ++n) {
+        const Real* frame = frames + static_cast<std::size_t>(n) * stride;
+
+        if (!detector.IsActive(frame[0]))
+            continue;
+
+        if (kept != n) {
+            Real* target = frames + static_cast<std::size_t>(kept) * stride;
+
+            for (unsigned int d = 0; d < stride; ++d)
+                target[d] = frame[d];
+        }
+
+        ++kept;
+    }
+
+    return kept;
+}
@@ -0,0 +1,241 @@
+/*!
+ *  This file is part of a speaker recognition group project (SOP, 2015-2016)
+ */
+
+#include "WaveFile.h"
+
+#include <cstring>
+
+namespace
+{
+    /*! \brief Read a little-endian value.
+     */
+    uint32_t ReadLittleEndian(const char* data, unsigned int size)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        uint32_t value = 0;
+
+        for (unsigned int i = 0; i < size; ++i)
+            value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+
+        return value;
+    }
+
+    const uint16_t FormatExtensible = 0xFFFE;
+}
+
+WaveFile::WaveFile()
+    : mSamples(nullptr),
+    mLength(0),
+    mSampleRate(0),
+    mChannelCount(0),
+    mBitsPerSample(0),
+    mSampleFormat(SampleFormat::PCM)
+{
+
+}
+
+WaveFile::~WaveFile()
+{
+
+}
+
+bool WaveFile::Open(const std::string& path)
+{
+    Close();
+
+    if (!mFile.Open(path)) {
+        std::cout << "Could not open wave file '" << path << "'." << std::endl;
+        return false;
+    }
+
+    const char* data = mFile.GetData();
+    std::size_t size = mFile.GetSize();
+
+    if (size < 12 || std::memcmp(data, "RIFF", 4) != 0
+        || std::memcmp(data + 8, "WAVE", 4) != 0) {
+        std::cout << "Invalid wave file '" << path << "'." << std::endl;
+        Close();
+        return false;
+    }
+
+    bool hasFormat = false;
+    uint16_t format = 0;
+    std::size_t offset = 12;
+
+    // Walk through the chunks, the data chunk must follow the format chunk.
+    while (offset + 8 <= size) {
+        const char* chunk = data + offset;
+        std::size_t chunkSize = ReadLittleEndian(chunk + 4, 4);
+        std::size_t available = Min(chunkSize, size - offset - 8);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            format = static_cast<uint16_t>(ReadLittleEndian(chunk + 8, 2));
+            mChannelCount = ReadLittleEndian(chunk + 10, 2);
+            mSampleRate = ReadLittleEndian(chunk + 12, 4);
+            mBitsPerSample = ReadLittleEndian(chunk + 22, 2);
+
+            // The actual format is the first field of the sub format GUID.
+            if (format == FormatExtensible && available >= 26)
+                format = static_cast<uint16_t>(ReadLittleEndian(chunk + 32, 2));
+
+            hasFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0 && hasFormat) {
+            unsigned int frameSize = mChannelCount * (mBitsPerSample / 8);
+
+            mSamples = chunk + 8;
+            mLength = (frameSize > 0)
+                ? static_cast<unsigned int>(available / frameSize) : 0;
+            break;
+        }
+
+        // Chunks are padded to even sizes.
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    bool supported = false;
+
+    if (format == static_cast<uint16_t>(SampleFormat::PCM)) {
+        mSampleFormat = SampleFormat::PCM;
+        supported = mBitsPerSample == 8 || mBitsPerSample == 16
+            || mBitsPerSample == 24 || mBitsPerSample == 32;
+    } else if (format == static_cast<uint16_t>(SampleFormat::IEEE_FLOAT)) {
+        mSampleFormat = SampleFormat::IEEE_FLOAT;
+        supported = mBitsPerSample == 32 || mBitsPerSample == 64;
+    }
+
+    if (mSamples == nullptr || !supported || mChannelCount == 0
+        || mSampleRate == 0) {
+        std::cout << "Unsupported wave file '" << path << "' (format "
+            << format << ", " << mBitsPerSample << " bits)." << std::endl;
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void WaveFile::Close()
+{
+    mFile.Close();
+
+    mSamples = nullptr;
+    mLength = 0;
+    mSampleRate = 0;
+    mChannelCount = 0;
+    mBitsPerSample = 0;
+    mSampleFormat = SampleFormat::PCM;
+}
+
+bool WaveFile::IsOpen() const
+{
+    return mSamples != nullptr;
+}
+
+unsigned int WaveFile::GetSampleRate() const
+{
+    return mSampleRate;
+}
+
+unsigned int WaveFile::GetChannelCount() const
+{
+    return mChannelCount;
+}
+
+WaveFile::SampleFormat WaveFile::GetSampleFormat() const
+{
+    return mSampleFormat;
+}
+
+unsigned int WaveFile::GetBitsPerSample() const
+{
+    return mBitsPerSample;
+}
+
+unsigned int WaveFile::GetLength() const
+{
+    return mLength;
+}
+
+const char* WaveFile::GetSampleData() const
+{
+    return mSamples;
+}
+
+unsigned int WaveFile::Read(unsigned int first, unsigned int count,
+    Real* output) const
+{
+    if (first >= mLength)
+        return 0;
+
+    count = Min(count, mLength - first);
+
+    unsigned int sampleSize = mBitsPerSample / 8;
+    unsigned int frameSize = mChannelCount * sampleSize;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(mSamples)
+        + static_cast<std::size_t>(first) * frameSize;
+
+    // The common case: 16-bit mono.
+    if (mSampleFormat == SampleFormat::PCM && mBitsPerSample == 16
+        && mChannelCount == 1) {
+        for (unsigned int i = 0; i < count; ++i) {
+            output[i] = static_cast<int16_t>(data[0] | (data[1] << 8));
+            data += 2;
+        }
+
+        return count;
+    }
+
+    Real scale = 1.0f / mChannelCount;
+
+    for (unsigned int i = 0; i < count; ++i) {
+        Real sum = 0.0f;
+
+        for (unsigned int c = 0; c < mChannelCount; ++c)
+            sum += GetSample(data + c * sampleSize);
+
+        output[i] = sum * scale;
+        data += frameSize;
+    }
+
+    return count;
+}
+
+Real WaveFile::GetSample(const unsigned char* data) const
+{
+    if (mSampleFormat == SampleFormat::IEEE_FLOAT) {
+        if (mBitsPerSample == 32) {
+            uint32_t bits = ReadLittleEndian(reinterpret_cast<const char*>(data), 4);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return static_cast<Real>(value * 32768.0f);
+        }
+
+        uint64_t bits = ReadLittleEndian(reinterpret_cast<const char*>(data), 4)
+            | (static_cast<uint64_t>(
+                ReadLittleEndian(reinterpret_cast<const char*>(data + 4), 4)) << 32);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return static_cast<Real>(value * 32768.0);
+    }
+
+    switch (mBitsPerSample) {
+    case 8:
+        // Unsigned with an offset of 128.
+        return static_cast<Real>((static_cast<int>(data[0]) - 128) * 256);
+    case 16:
+        return static_cast<int16_t>(data[0] | (data[1] << 8));
+    case 24: {
+        int32_t value = static_cast<int32_t>(
+            (static_cast<uint32_t>(data[0]) << 8)
+            | (static_cast<uint32_t>(data[1]) << 16)
+            | (static_cast<uint32_t>(data[2]) << 24));
+        return static_cast<Real>(value / 65536.0);
+    }
+    default: {
+        int32_t value = static_cast<int32_t>(
+            ReadLittleEndian(reinterpret_cast<const char*>(data), 4));
+        return static_cast<Real>(value / 65536.0);
+    }
+    }
+}